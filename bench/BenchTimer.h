@@ -0,0 +1,36 @@
+#ifndef BENCH_TIMER_H
+#define BENCH_TIMER_H
+
+#include <algorithm>
+#include <chrono>
+
+namespace benchTimer {
+    /**
+     * @brief Calls func repeats times and times each call. The fastest is the one least disturbed by the rest of the
+     * machine, so that is the one returned.
+     *
+     * @return The fastest call in nanoseconds
+     */
+    template<typename Func>
+    double fastestOf(int repeats, Func func) {
+        double fastest = 1e300;
+        for(int i = 0; i < repeats; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            func();
+            auto end = std::chrono::steady_clock::now();
+            fastest = std::min(fastest, std::chrono::duration<double, std::nano>(end - start).count());
+        }
+        return fastest;
+    }
+
+    /**
+     * @brief Stores a result where the compiler can't see it being thrown away, so that the work behind it is kept.
+     */
+    template<typename T>
+    void keep(T value) {
+        static volatile T sink;
+        sink = value;
+    }
+};
+
+#endif
\ No newline at end of file
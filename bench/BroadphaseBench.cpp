@@ -0,0 +1,153 @@
+#include "BenchTimer.h"
+#include "EntityComponentSystem.h"
+#include "CollisionSystem.h"
+#include "SpatialHash.h"
+#include "CollisionComponent.h"
+#include "TransformComponent.h"
+#include "PhysicsComponent.h"
+#include "HealthComponent.h"
+#include "ProjectileComponent.h"
+#include "PlayerComponent.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Projectile vs enemy collisions with thousands of each, spread over a 4096x4096 area. Three ways of finding the hits
+// are timed for one frame: CollisionSystem, which makes a single SpatialHash::queryPairs() pass; one spatial hash query
+// per projectile, as CollisionSystem used to; and the check of every projectile against every enemy that the
+// broadphase replaced. Each has to find the same projectiles hitting something.
+
+namespace {
+    const std::pair<int, int> SIZES[] = {{500, 1000}, {2000, 4000}, {5000, 10000}};
+    const int REPEATS = 5;
+    const float WORLD_SIZE = 4096.f;
+    const int CELL_SIZE = 16;
+
+    struct World {
+        std::unique_ptr<EntityComponentSystem> ecs;
+        std::shared_ptr<CollisionSystem> collision;
+        std::vector<Entity> projectiles;
+    };
+
+    World createWorld(int enemies, int projectiles) {
+        World world;
+        world.ecs = std::make_unique<EntityComponentSystem>();
+        world.ecs->init();
+        world.collision = world.ecs->registerSystem<CollisionSystem>();
+        world.collision->setBroadphaseCellSize(CELL_SIZE);
+        std::mt19937 random(5);
+        std::uniform_real_distribution<float> position(0.f, WORLD_SIZE);
+        auto add = [&](bool projectile) {
+            Entity entity = world.ecs->createEntity();
+            strb::vec2 pos = {position(random), position(random)};
+            world.ecs->addComponent<TransformComponent>(entity, TransformComponent{pos, pos});
+            CollisionComponent collisionComp;
+            collisionComp.collisionRect = {(int) pos.x, (int) pos.y, projectile ? 8 : 16, projectile ? 4 : 16};
+            world.ecs->addComponent<CollisionComponent>(entity, collisionComp);
+            world.ecs->addComponent<PhysicsComponent>(entity, PhysicsComponent{});
+            if(projectile) {
+                world.ecs->addComponent<ProjectileComponent>(entity, ProjectileComponent{});
+                world.projectiles.push_back(entity);
+            }
+            else {
+                world.ecs->addComponent<HealthComponent>(entity, HealthComponent{});
+            }
+        };
+        for(int i = 0; i < enemies; ++i) add(false);
+        for(int i = 0; i < projectiles; ++i) add(true);
+        return world;
+    }
+
+    // Moves every projectile a few pixels, as a frame would
+    void moveProjectiles(World& world) {
+        for(Entity projectile : world.projectiles) {
+            auto& transform = world.ecs->getComponent<TransformComponent>(projectile);
+            transform.position.x += 3.f;
+            if(transform.position.x > WORLD_SIZE) transform.position.x -= WORLD_SIZE;
+            world.ecs->markChanged<TransformComponent>(projectile);
+        }
+    }
+
+    // CollisionSystem::checkForProjectileAndEnemyCollisions() as it was before the broadphase, without the damage
+    int checkEveryPair(EntityComponentSystem& ecs) {
+        int hits = 0;
+        auto targets = ecs.view<HealthComponent, CollisionComponent, TransformComponent, PhysicsComponent>().exclude<PlayerComponent>();
+        for(auto [proj, projectileComp, projCollision, projTransform] : ecs.view<ProjectileComponent, CollisionComponent, TransformComponent>()) {
+            for(auto [ent, health, entCollision, entTransform, physics] : targets) {
+                if(SDL_HasIntersection(&projCollision.collisionRect, &entCollision.collisionRect)) {
+                    ++hits;
+                    break;
+                }
+            }
+        }
+        return hits;
+    }
+
+    // CollisionSystem::checkForProjectileAndEnemyCollisions() with one query per projectile, without the damage
+    int checkEachProjectile(EntityComponentSystem& ecs, const SpatialHash& hash, std::vector<Entity>& candidates) {
+        int hits = 0;
+        for(auto [proj, projectileComp, projCollision, projTransform] : ecs.view<ProjectileComponent, CollisionComponent, TransformComponent>()) {
+            hash.query(projCollision.collisionRect, candidates);
+            for(auto ent : candidates) {
+                if(ent == proj || !ecs.hasComponent<HealthComponent>(ent)) continue;
+                if(SDL_HasIntersection(&projCollision.collisionRect, &ecs.getComponent<CollisionComponent>(ent).collisionRect)) {
+                    ++hits;
+                    break;
+                }
+            }
+        }
+        return hits;
+    }
+
+    void run(int enemies, int projectiles) {
+        World world = createWorld(enemies, projectiles);
+        SpatialHash hash(CELL_SIZE);
+        std::vector<Entity> candidates;
+        double sync = 1e300;
+        double pairQuery = 1e300;
+        double perProjectile = 1e300;
+        double everyPair = 1e300;
+        int pairQueryHits = 0;
+        int perProjectileHits = 0;
+        int everyPairHits = 0;
+        bool agree = true;
+        for(int repeat = 0; repeat < REPEATS; ++repeat) {
+            moveProjectiles(world);
+            sync = std::min(sync, benchTimer::fastestOf(1, [&]() {
+                world.collision->updateCollisionRects();
+            }));
+
+            pairQuery = std::min(pairQuery, benchTimer::fastestOf(1, [&]() {
+                world.collision->checkForProjectileAndEnemyCollisions(1.f / 60.f);
+            }));
+            // Each hit queues its projectile for destruction. Nothing is destroyed so every run sees the same world.
+            pairQueryHits = (int) world.ecs->getCommandBuffer().take().size();
+
+            world.ecs->view<CollisionComponent>().each([&](Entity entity, CollisionComponent& collisionComp) {
+                hash.update(entity, collisionComp.collisionRect);
+            });
+            perProjectile = std::min(perProjectile, benchTimer::fastestOf(1, [&]() {
+                perProjectileHits = checkEachProjectile(*world.ecs, hash, candidates);
+            }));
+
+            everyPair = std::min(everyPair, benchTimer::fastestOf(1, [&]() {
+                everyPairHits = checkEveryPair(*world.ecs);
+            }));
+            agree = agree && pairQueryHits == perProjectileHits && perProjectileHits == everyPairHits;
+        }
+        std::printf("%7d  %11d  %8.0f  %10.0f  %14.0f  %10.0f   %d hits%s\n", enemies, projectiles, sync / 1000.0,
+            pairQuery / 1000.0, perProjectile / 1000.0, everyPair / 1000.0, everyPairHits,
+            agree ? "" : ", CHECKS DISAGREE");
+    }
+}
+
+int main() {
+    std::printf("us per frame, fastest of %d frames\n", REPEATS);
+    std::printf("enemies  projectiles  sync      pair query  per-projectile  every pair\n");
+    for(auto [enemies, projectiles] : SIZES) run(enemies, projectiles);
+    return 0;
+}
\ No newline at end of file
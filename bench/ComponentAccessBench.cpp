@@ -0,0 +1,139 @@
+#include "BenchTimer.h"
+#include "EntityComponentSystem.h"
+#include "ComponentArray.h"
+#include "TransformComponent.h"
+#include "PhysicsComponent.h"
+#include "CollisionComponent.h"
+#include "EdgeCheckComponent.h"
+
+#include <cstdio>
+#include <memory>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+// Cost of one component access through the ECS, against the lookup it replaced: the component array found by hashing
+// typeid(T).name() into two unordered_maps and handed back as a shared_ptr. The old lookup is rebuilt here over the
+// same ComponentArray, so only the lookup differs.
+
+namespace {
+    const int ENTITIES = 500;
+    const int PASSES = 2000;
+    const int REPEATS = 9;
+
+    class TypeNameLookup {
+    public:
+        template<typename T>
+        T& getComponent(Entity entity) {
+            return getComponentArray<T>()->getData(entity);
+        }
+
+        template<typename T>
+        bool hasComponent(Entity entity) {
+            return getComponentArray<T>()->tryGetData(entity) != nullptr;
+        }
+
+        template<typename T>
+        void addComponent(Entity entity, T component) {
+            const char* typeName = typeid(T).name();
+            if(_componentTypes.find(typeName) == _componentTypes.end()) {
+                _componentTypes[typeName] = (ComponentType) _componentTypes.size();
+                _componentArrays[typeName] = std::make_shared<ComponentArray<T>>();
+            }
+            getComponentArray<T>()->insertData(entity, component, 0);
+        }
+
+    private:
+        template<typename T>
+        std::shared_ptr<ComponentArray<T>> getComponentArray() {
+            const char* typeName = typeid(T).name();
+            if(_componentTypes.find(typeName) == _componentTypes.end()) return nullptr;
+            return std::static_pointer_cast<ComponentArray<T>>(_componentArrays[typeName]);
+        }
+
+        std::unordered_map<const char*, ComponentType> _componentTypes;
+        std::unordered_map<const char*, std::shared_ptr<IComponentArray>> _componentArrays;
+    };
+
+    // Reads three components of every entity, like the physics and collision passes do
+    template<typename World>
+    double timeGet(World& world, const std::vector<Entity>& entities) {
+        float sink = 0.f;
+        double ns = benchTimer::fastestOf(REPEATS, [&]() {
+            for(int pass = 0; pass < PASSES; ++pass) {
+                for(Entity entity : entities) {
+                    auto& transform = world.template getComponent<TransformComponent>(entity);
+                    auto& physics = world.template getComponent<PhysicsComponent>(entity);
+                    auto& collision = world.template getComponent<CollisionComponent>(entity);
+                    transform.position.x += physics.velocity.x;
+                    collision.collisionRect.x = (int) transform.position.x;
+                    sink += (float) transform.position.x;
+                }
+            }
+        });
+        benchTimer::keep(sink);
+        return ns / (3.0 * PASSES * entities.size());
+    }
+
+    // Reads a component half the entities have, checking for it first
+    double timeHasAndGet(TypeNameLookup& world, const std::vector<Entity>& entities) {
+        int hits = 0;
+        double ns = benchTimer::fastestOf(REPEATS, [&]() {
+            for(int pass = 0; pass < PASSES; ++pass) {
+                for(Entity entity : entities) {
+                    if(world.hasComponent<EdgeCheckComponent>(entity)) {
+                        hits += world.getComponent<EdgeCheckComponent>(entity).onLeftEdge + 1;
+                    }
+                }
+            }
+        });
+        benchTimer::keep(hits);
+        return ns / ((double) PASSES * entities.size());
+    }
+
+    double timeTryGet(EntityComponentSystem& world, const std::vector<Entity>& entities) {
+        int hits = 0;
+        double ns = benchTimer::fastestOf(REPEATS, [&]() {
+            for(int pass = 0; pass < PASSES; ++pass) {
+                for(Entity entity : entities) {
+                    if(auto edgeCheck = world.tryGetComponent<EdgeCheckComponent>(entity)) {
+                        hits += edgeCheck->onLeftEdge + 1;
+                    }
+                }
+            }
+        });
+        benchTimer::keep(hits);
+        return ns / ((double) PASSES * entities.size());
+    }
+}
+
+int main() {
+    auto ecs = std::make_unique<EntityComponentSystem>();
+    ecs->init();
+    TypeNameLookup lookup;
+    std::vector<Entity> entities;
+    for(int i = 0; i < ENTITIES; ++i) {
+        Entity entity = ecs->createEntity();
+        entities.push_back(entity);
+        TransformComponent transform;
+        transform.position = {(float) i, 0.f};
+        ecs->addComponent<TransformComponent>(entity, transform);
+        ecs->addComponent<PhysicsComponent>(entity, PhysicsComponent{});
+        ecs->addComponent<CollisionComponent>(entity, CollisionComponent{});
+        lookup.addComponent<TransformComponent>(entity, transform);
+        lookup.addComponent<PhysicsComponent>(entity, PhysicsComponent{});
+        lookup.addComponent<CollisionComponent>(entity, CollisionComponent{});
+        if(i % 2 == 0) {
+            ecs->addComponent<EdgeCheckComponent>(entity, EdgeCheckComponent{});
+            lookup.addComponent<EdgeCheckComponent>(entity, EdgeCheckComponent{});
+        }
+    }
+
+    std::printf("%d entities, fastest of %d runs of %d passes\n", ENTITIES, REPEATS, PASSES);
+    std::printf("                     typeid lookup    static type ID\n");
+    std::printf("getComponent         %8.2f ns       %8.2f ns   per access\n",
+        timeGet(lookup, entities), timeGet(*ecs, entities));
+    std::printf("has + get / tryGet   %8.2f ns       %8.2f ns   per entity\n",
+        timeHasAndGet(lookup, entities), timeTryGet(*ecs, entities));
+    return 0;
+}
\ No newline at end of file
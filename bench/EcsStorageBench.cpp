@@ -0,0 +1,121 @@
+#include "BenchTimer.h"
+#include "EntityComponentSystem.h"
+#include "TransformComponent.h"
+#include "PhysicsComponent.h"
+#include "CollisionComponent.h"
+#include "RenderComponent.h"
+#include "HealthComponent.h"
+#include "PlayerComponent.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Compares the two component storages. Built once with each, since the storage is picked at compile time. The world is
+// a mix of signatures like the game's: everything has a transform and render component, 3/4 have physics, 1/2 have
+// collision and 1/8 have health.
+
+namespace {
+#ifdef ECS_ARCHETYPE_STORAGE
+    const char* STORAGE = "archetype";
+#else
+    const char* STORAGE = "sparse";
+#endif
+    const int SIZES[] = {500, 5000, 50000};
+    const int REPEATS = 5;
+    // Every pass touches about this many entities, so small worlds get more passes
+    const int ENTITIES_PER_RUN = 2000000;
+
+    void populate(EntityComponentSystem& ecs, int count, std::vector<Entity>& entities) {
+        entities.clear();
+        for(int i = 0; i < count; ++i) {
+            Entity entity = ecs.createEntity();
+            entities.push_back(entity);
+            TransformComponent transform;
+            transform.position = {(float) (i % 1000), (float) (i / 1000)};
+            ecs.addComponent<TransformComponent>(entity, transform);
+            ecs.addComponent<RenderComponent>(entity, RenderComponent{});
+            if(i % 4 != 3) {
+                PhysicsComponent physics;
+                physics.velocity = {1.f, 0.f};
+                physics.maxVelocity = {100.f, 100.f};
+                ecs.addComponent<PhysicsComponent>(entity, physics);
+            }
+            if(i % 2 == 0) ecs.addComponent<CollisionComponent>(entity, CollisionComponent{});
+            if(i % 8 == 0) ecs.addComponent<HealthComponent>(entity, HealthComponent{});
+            if(i == 0) ecs.addComponent<PlayerComponent>(entity, PlayerComponent{});
+        }
+    }
+
+    void destroyAll(EntityComponentSystem& ecs, const std::vector<Entity>& entities) {
+        for(size_t i = entities.size(); i-- > 0;) ecs.destroyEntity(entities[i]);
+    }
+
+    void run(int count) {
+        auto ecs = std::make_unique<EntityComponentSystem>();
+        ecs->init();
+        std::vector<Entity> entities;
+        int passes = std::max(ENTITIES_PER_RUN / count, 1);
+
+        // Creating and destroying reuse the same slots every time after the first
+        double create = benchTimer::fastestOf(REPEATS, [&]() {
+            destroyAll(*ecs, entities);
+            populate(*ecs, count, entities);
+        });
+
+        double physics = benchTimer::fastestOf(REPEATS, [&]() {
+            for(int pass = 0; pass < passes; ++pass) {
+                ecs->view<PhysicsComponent, TransformComponent>().each(
+                    [](Entity, PhysicsComponent& physics, TransformComponent& transform) {
+                    transform.lastPosition = transform.position;
+                    transform.position.x += physics.velocity.x;
+                    physics.velocity.y += physics.gravity;
+                    if(physics.velocity.y > physics.maxVelocity.y) physics.velocity.y = physics.maxVelocity.y;
+                    transform.position.y += physics.velocity.y;
+                });
+            }
+        });
+
+        double collision = benchTimer::fastestOf(REPEATS, [&]() {
+            for(int pass = 0; pass < passes; ++pass) {
+                auto view = ecs->view<CollisionComponent, PhysicsComponent, TransformComponent>().exclude<PlayerComponent>();
+                for(auto [entity, collisionComp, physics, transform] : view) {
+                    collisionComp.collisionRect.x = (int) (transform.position.x + collisionComp.collisionRectOffset.x);
+                    collisionComp.collisionRect.y = (int) (transform.position.y + collisionComp.collisionRectOffset.y);
+                    if(physics.velocity.x < 0.f) collisionComp.collidingLeft = true;
+                }
+            }
+        });
+
+        std::mt19937 random(1);
+        std::vector<Entity> lookups(1 << 16);
+        for(auto& lookup : lookups) lookup = entities[random() % entities.size()];
+        float sink = 0.f;
+        double get = benchTimer::fastestOf(REPEATS, [&]() {
+            for(int pass = 0; pass < passes; ++pass) {
+                for(int i = 0; i < count; ++i) {
+                    sink += (float) ecs->getComponent<TransformComponent>(lookups[(pass * count + i) & 0xFFFF]).position.x;
+                }
+            }
+        });
+        benchTimer::keep(sink);
+
+        double destroy = benchTimer::fastestOf(1, [&]() {
+            destroyAll(*ecs, entities);
+        });
+        entities.clear();
+
+        double perPass = (double) passes * count;
+        std::printf("%6d  %8.1f  %8.2f  %8.2f  %8.2f  %8.1f\n", count, create / count, physics / perPass,
+            collision / perPass, get / perPass, destroy / count);
+    }
+}
+
+int main() {
+    std::printf("%s storage, ns per entity, fastest of %d runs\n", STORAGE, REPEATS);
+    std::printf("  size    create   physics  3 comps     get   destroy\n");
+    for(int count : SIZES) run(count);
+    return 0;
+}
\ No newline at end of file
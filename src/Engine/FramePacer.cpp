@@ -0,0 +1,35 @@
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <thread>
+
+FramePacer::FramePacer(double targetFrameTime) {
+    setTargetFrameTime(targetFrameTime);
+    _nextFrame = Clock::now() + _targetFrameTime;
+}
+
+void FramePacer::setTargetFrameTime(double seconds) {
+    _targetFrameTime = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+}
+
+void FramePacer::waitForNextFrame() {
+    Clock::time_point now = Clock::now();
+    if(now >= _nextFrame) {
+        // Already late, so start counting from here instead of trying to catch up
+        _nextFrame = now + _targetFrameTime;
+        return;
+    }
+
+    Clock::time_point wakeUp = _nextFrame - _spinTime;
+    if(now < wakeUp) {
+        std::this_thread::sleep_until(wakeUp);
+        Clock::duration overslept = Clock::now() - wakeUp;
+        // Keep spins short but make sure the next sleep wakes up in time
+        _spinTime = std::max(overslept + std::chrono::microseconds(200), _spinTime - std::chrono::microseconds(50));
+        _spinTime = std::min<Clock::duration>(_spinTime, std::chrono::milliseconds(4));
+    }
+    while(Clock::now() < _nextFrame) {
+        std::this_thread::yield();
+    }
+    _nextFrame += _targetFrameTime;
+}
\ No newline at end of file
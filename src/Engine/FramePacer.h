@@ -0,0 +1,37 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <chrono>
+
+/**
+ * @brief Keeps frames a fixed time apart without keeping a core busy. Waiting sleeps for most of the gap and only
+ * spins for the last stretch, since a sleep can wake up later than asked. How late sleeps wake up is measured as it
+ * goes, so the spin stays as short as the platform's timer allows.
+ */
+class FramePacer {
+public:
+    explicit FramePacer(double targetFrameTime = 1.0 / 60.0);
+    ~FramePacer() = default;
+
+    /**
+     * @brief Sets how far apart frames should be, e.g. 1 / the display's refresh rate.
+     */
+    void setTargetFrameTime(double seconds);
+
+    /**
+     * @brief Blocks until the next frame is due. A frame that ran long is not made up for by shortening the ones
+     * after it, since that would only bunch them up.
+     */
+    void waitForNextFrame();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Clock::duration _targetFrameTime;
+    Clock::time_point _nextFrame;
+    // How much earlier than the deadline sleeping stops. Grows to the longest oversleep seen, and shrinks slowly.
+    Clock::duration _spinTime = std::chrono::milliseconds(1);
+
+};
+
+#endif
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "Game.h"
 #include "SpritesheetRegistry.h"
 
+#include <algorithm>
 #include <chrono>
 #include <SDL_image.h>
 #include <SDL_ttf.h>
@@ -130,77 +131,7 @@ bool Game::loadResources() {
     _text[TextSize::LARGE] = largeText;
 
     // Spritesheets
-    std::shared_ptr<Spritesheet> dialogueSpritesheet = std::make_shared<Spritesheet>();
-    if(!dialogueSpritesheet->load(_renderer, "res/spritesheet/dialogue_box.png")) return false;
-    dialogueSpritesheet->setTileWidth(320);
-    dialogueSpritesheet->setTileHeight(32);
-    SpritesheetRegistry::addSpritesheet(SpritesheetID::DIALOGUE_BOX, dialogueSpritesheet);
-    
-    std::shared_ptr<Spritesheet> defaultTileset = std::make_shared<Spritesheet>();
-    if(!defaultTileset->load(_renderer, "res/spritesheet/default_tileset.png")) return false;
-    defaultTileset->setTileWidth(16);
-    defaultTileset->setTileHeight(16);
-    SpritesheetRegistry::addSpritesheet(SpritesheetID::DEFAULT_TILESET, defaultTileset);
-    
-    std::shared_ptr<Spritesheet> playerSpritesheet = std::make_shared<Spritesheet>();
-    if(!playerSpritesheet->load(_renderer, "res/spritesheet/player.png")) return false;
-    playerSpritesheet->setTileWidth(24);
-    playerSpritesheet->setTileHeight(24);
-    SpritesheetRegistry::addSpritesheet(SpritesheetID::PLAYER_SPRITESHEET, playerSpritesheet);
-    
-    std::shared_ptr<Spritesheet> checkpoint = std::make_shared<Spritesheet>();
-    if(!checkpoint->load(_renderer, "res/spritesheet/checkpoint.png")) return false;
-    checkpoint->setTileWidth(16);
-    checkpoint->setTileHeight(16);
-    SpritesheetRegistry::addSpritesheet(SpritesheetID::CHECKPOINT, checkpoint);
-    
-    std::shared_ptr<Spritesheet> weaponPickup = std::make_shared<Spritesheet>();
-    if(!weaponPickup->load(_renderer, "res/spritesheet/weapon_pickup.png")) return false;
-    weaponPickup->setTileWidth(16);
-    weaponPickup->setTileHeight(16);
-    SpritesheetRegistry::addSpritesheet(SpritesheetID::WEAPON_PICKUP, weaponPickup);
-    
-    std::shared_ptr<Spritesheet> jumpPickup = std::make_shared<Spritesheet>();
-    if(!jumpPickup->load(_renderer, "res/spritesheet/jump_pickup.png")) return false;
-    jumpPickup->setTileWidth(16);
-    jumpPickup->setTileHeight(16);
-    SpritesheetRegistry::addSpritesheet(SpritesheetID::JUMP_PICKUP, jumpPickup);
-    
-    std::shared_ptr<Spritesheet> bootsPickup = std::make_shared<Spritesheet>();
-    if(!bootsPickup->load(_renderer, "res/spritesheet/boots_pickup.png")) return false;
-    bootsPickup->setTileWidth(16);
-    bootsPickup->setTileHeight(16);
-    SpritesheetRegistry::addSpritesheet(SpritesheetID::BOOTS_PICKUP, bootsPickup);
-    
-    std::shared_ptr<Spritesheet> walljumpPickup = std::make_shared<Spritesheet>();
-    if(!walljumpPickup->load(_renderer, "res/spritesheet/walljump_pickup.png")) return false;
-    walljumpPickup->setTileWidth(16);
-    walljumpPickup->setTileHeight(16);
-    SpritesheetRegistry::addSpritesheet(SpritesheetID::WALLJUMP_PICKUP, walljumpPickup);
-    
-    std::shared_ptr<Spritesheet> projectile = std::make_shared<Spritesheet>();
-    if(!projectile->load(_renderer, "res/spritesheet/projectile.png")) return false;
-    projectile->setTileWidth(8);
-    projectile->setTileHeight(8);
-    SpritesheetRegistry::addSpritesheet(SpritesheetID::PROJECTILE, projectile);
-    
-    std::shared_ptr<Spritesheet> flag = std::make_shared<Spritesheet>();
-    if(!flag->load(_renderer, "res/spritesheet/flag.png")) return false;
-    flag->setTileWidth(16);
-    flag->setTileHeight(16);
-    SpritesheetRegistry::addSpritesheet(SpritesheetID::FLAG, flag);
-    
-    std::shared_ptr<Spritesheet> engineSpritesheet = std::make_shared<Spritesheet>();
-    if(!engineSpritesheet->load(_renderer, "res/spritesheet/engine.png")) return false;
-    engineSpritesheet->setTileWidth(16);
-    engineSpritesheet->setTileHeight(16);
-    SpritesheetRegistry::addSpritesheet(SpritesheetID::ENGINE_SPRITESHEET, engineSpritesheet);
-    
-    std::shared_ptr<Spritesheet> splashScreen = std::make_shared<Spritesheet>();
-    if(!splashScreen->load(_renderer, "res/spritesheet/splash_screen.png")) return false;
-    splashScreen->setTileWidth(320);
-    splashScreen->setTileHeight(180);
-    SpritesheetRegistry::addSpritesheet(SpritesheetID::SPLASH_SCREEN, splashScreen);
+    if(!SpritesheetRegistry::loadSpritesheets(_renderer)) return false;
 
     // Audio
     _audioPlayer = std::make_unique<Audio>();
@@ -219,12 +150,11 @@ bool Game::loadResources() {
 
 void Game::startGameLoop() {
     SDL_Event e;
-    auto startTime = std::chrono::high_resolution_clock::now();
-    std::chrono::milliseconds dTime = std::chrono::milliseconds(0); // deltaTime
-    Uint32 millisecondCount = 0;
+    auto previousTime = std::chrono::steady_clock::now();
+    double accumulator = 0.0;
+    double fpsTime = 0.0;
     Uint32 frames = 0;
-    float frameWait = 1.f / 60.f;
-    float frameRemainder = 0.f;
+    updateFramePacing();
     while(_exitFlag == false) {
         // Event Handling
         while(SDL_PollEvent(&e) != 0) {
@@ -247,6 +177,10 @@ void Game::startGameLoop() {
                 case SDL_MOUSEBUTTONUP:
                     _currentState->handleMouseInput(e);
                     break;
+                case SDL_WINDOWEVENT:
+                    // The window may have moved to a display with a different refresh rate
+                    if(e.window.event == SDL_WINDOWEVENT_MOVED) updateFramePacing();
+                    break;
                 default:
                     break;
             }
@@ -264,6 +198,8 @@ void Game::startGameLoop() {
             _currentState->setAudioPlayer(_audioPlayer.get());
             _currentState->setSettings(_settings.get());
             _currentState->init();
+            // Tick the new state once before it is first rendered
+            accumulator = std::max(accumulator, SIMULATION_TIMESTEP);
         }
 
         // Settings changed
@@ -282,31 +218,53 @@ void Game::startGameLoop() {
             }
             SDL_SetWindowPosition(_window, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED);
             _currentState->completeSettingsChange();
+            updateFramePacing();
         }
 
-        dTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - startTime);
-        if(dTime.count() >= (frameWait * 1000.f - frameRemainder)) {
-            startTime = std::chrono::high_resolution_clock::now();
-            millisecondCount += dTime.count();
-            frameRemainder += std::abs(frameWait * 1000.f - std::ceil(frameWait * 1000.f));
-            if(frameRemainder > 1.f) frameRemainder = 0.f;
-            _currentState->tick(frameWait);
-            _currentState->render();
-            frames++;
-
+        // The simulation always moves in fixed steps, however long frames take. Time that doesn't make up a whole
+        // step is carried over to the next frame.
+        auto now = std::chrono::steady_clock::now();
+        double frameTime = std::chrono::duration<double>(now - previousTime).count();
+        previousTime = now;
+        accumulator += frameTime;
+        fpsTime += frameTime;
+        int steps = 0;
+        while(accumulator >= SIMULATION_TIMESTEP && steps < MAX_STEPS_PER_FRAME) {
+            _currentState->tick(SIMULATION_TIMESTEP);
+            accumulator -= SIMULATION_TIMESTEP;
+            ++steps;
             if(_currentState->isRequestingQuit()) _exitFlag = true;
+            if(_exitFlag || _currentState->getNextState() != nullptr) break;
         }
+        // Too far behind to catch up (e.g. the window was being dragged). Drop the backlog rather than spending the
+        // next frames catching up, which would only put us further behind.
+        if(steps == MAX_STEPS_PER_FRAME) accumulator = std::min(accumulator, SIMULATION_TIMESTEP);
+
+        if(_exitFlag) break;
+        _currentState->setRenderInterpolation(std::min(accumulator / SIMULATION_TIMESTEP, 1.0));
+        _currentState->render();
+        frames++;
+        _framePacer.waitForNextFrame();
 
-        if(millisecondCount >= 1000) {
+        if(fpsTime >= 1.0) {
             std::cout << "FPS: " << frames << std::endl;
             frames = 0;
-            millisecondCount = 0;
+            fpsTime = 0.0;
         }
     }
 
     exit();
 }
 
+void Game::updateFramePacing() {
+    // Render once per refresh of the display the window is on. Vsync usually does this already, but the pacer
+    // sleeps instead of spinning when it doesn't.
+    SDL_DisplayMode mode;
+    int refreshRate = 0;
+    if(SDL_GetCurrentDisplayMode(SDL_GetWindowDisplayIndex(_window), &mode) == 0) refreshRate = mode.refresh_rate;
+    _framePacer.setTargetFrameTime(1.0 / (refreshRate > 0 ? refreshRate : 60));
+}
+
 void Game::exit() {
     SDL_DestroyWindow(_window);
     SDL_DestroyRenderer(_renderer);
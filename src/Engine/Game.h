@@ -4,6 +4,7 @@
 #include "State.h"
 #include "GameState.h"
 #include "MainMenuState.h"
+#include "FramePacer.h"
 
 class Game {
 public:
@@ -16,6 +17,11 @@ public:
     void exit();
 
 private:
+    /**
+     * @brief Matches the frame pacer to the refresh rate of the display the window is on.
+     */
+    void updateFramePacing();
+
     const char * _windowTitle;
     const char * _tinyTextFontPath = "res/font/04b03.ttf";
     const char * _smallTextFontPath = "res/font/edit-undo.brk.ttf";
@@ -25,12 +31,17 @@ private:
     const int GAME_WIDTH = 320;
     const int GAME_HEIGHT = 180;
     int _renderScale = 4;
+    // Length of one simulation tick, in seconds
+    const double SIMULATION_TIMESTEP = 1.0 / 60.0;
+    // Most ticks run before rendering a frame. Beyond this, the simulation slows down instead of falling behind.
+    const int MAX_STEPS_PER_FRAME = 5;
 
     SDL_Window* _window = nullptr;
     SDL_Renderer* _renderer = nullptr;
     SDL_GameController* _controller = nullptr;
 
     bool _exitFlag = false;
+    FramePacer _framePacer;
 
     State* _currentState = nullptr;
     State* _nextState = nullptr;
@@ -0,0 +1,126 @@
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <cassert>
+#include <cstdint>
+
+namespace strb {
+    /**
+     * @brief Signed Q16.16 fixed-point number. Every operation is integer arithmetic, so results are the same on every
+     * compiler, optimisation level and machine, which float maths does not promise. Range is about +-32767 with a
+     * precision of 1/65536.
+     *
+     * Ints, floats and doubles convert in implicitly, rounding to the nearest step, so constants can be written as
+     * usual. Converting out is explicit, which keeps float maths from creeping back into code that uses this type.
+     */
+    struct fixed {
+        static constexpr int FRACTION_BITS = 16;
+        static constexpr std::int32_t ONE = 1 << FRACTION_BITS;
+
+        constexpr fixed() : raw(0) {}
+        constexpr fixed(int i) : raw((std::int32_t) ((std::uint32_t) i << FRACTION_BITS)) {}
+        constexpr fixed(float f) : fixed((double) f) {}
+        constexpr fixed(double d) : raw((std::int32_t) (d >= 0 ? d * ONE + 0.5 : d * ONE - 0.5)) {}
+
+        /**
+         * @brief Makes a fixed from its raw Q16.16 value, e.g. one read back from a replay or checksum.
+         */
+        static constexpr fixed fromRaw(std::int32_t raw) {
+            fixed f;
+            f.raw = raw;
+            return f;
+        }
+
+        /**
+         * @brief Truncates toward zero, like casting a float to an int.
+         */
+        constexpr explicit operator int() const {
+            return raw >= 0 ? raw >> FRACTION_BITS : -((-raw) >> FRACTION_BITS);
+        }
+
+        constexpr explicit operator float() const {
+            return (float) raw / ONE;
+        }
+
+        constexpr explicit operator double() const {
+            return (double) raw / ONE;
+        }
+
+        constexpr fixed operator-() const {
+            return fromRaw(-raw);
+        }
+
+        constexpr fixed& operator+=(fixed const& f) {
+            raw += f.raw;
+            return *this;
+        }
+
+        constexpr fixed& operator-=(fixed const& f) {
+            raw -= f.raw;
+            return *this;
+        }
+
+        // Products and quotients are worked out in 64 bits. The shift rounds toward negative infinity on every
+        // compiler we build with.
+        constexpr fixed& operator*=(fixed const& f) {
+            raw = (std::int32_t) (((std::int64_t) raw * f.raw) >> FRACTION_BITS);
+            return *this;
+        }
+
+        // Dividing by zero is undefined, as it is for ints, rather than giving an infinity like a float would
+        constexpr fixed& operator/=(fixed const& f) {
+            assert(f.raw != 0 && "fixed division by zero");
+            raw = (std::int32_t) (((std::int64_t) raw * ONE) / f.raw);
+            return *this;
+        }
+
+        friend constexpr fixed operator+(fixed a, fixed const& b) { return a += b; }
+        friend constexpr fixed operator-(fixed a, fixed const& b) { return a -= b; }
+        friend constexpr fixed operator*(fixed a, fixed const& b) { return a *= b; }
+        friend constexpr fixed operator/(fixed a, fixed const& b) { return a /= b; }
+
+        friend constexpr bool operator==(fixed const& a, fixed const& b) { return a.raw == b.raw; }
+        friend constexpr bool operator!=(fixed const& a, fixed const& b) { return a.raw != b.raw; }
+        friend constexpr bool operator<(fixed const& a, fixed const& b) { return a.raw < b.raw; }
+        friend constexpr bool operator>(fixed const& a, fixed const& b) { return a.raw > b.raw; }
+        friend constexpr bool operator<=(fixed const& a, fixed const& b) { return a.raw <= b.raw; }
+        friend constexpr bool operator>=(fixed const& a, fixed const& b) { return a.raw >= b.raw; }
+
+        std::int32_t raw;
+    };
+
+    constexpr fixed abs(fixed const& f) {
+        return f.raw < 0 ? -f : f;
+    }
+
+    constexpr fixed floor(fixed const& f) {
+        return fixed::fromRaw(f.raw & ~(fixed::ONE - 1));
+    }
+
+    constexpr fixed ceil(fixed const& f) {
+        return -floor(-f);
+    }
+
+    /**
+     * @brief Cosine of an angle in radians, worked out with a Taylor series in fixed maths rather than libm, so it
+     * gives the same answer everywhere. Accurate to within a few steps.
+     */
+    constexpr fixed cos(fixed angle) {
+        constexpr fixed PI = 3.14159265358979323846;
+        constexpr fixed HALF_PI = 1.57079632679489661923;
+        constexpr fixed TWO_PI = 6.28318530717958647692;
+        // Bring the angle into [0, pi], then into [0, pi / 2] using cos(pi - x) = -cos(x)
+        angle = fixed::fromRaw(angle.raw % TWO_PI.raw);
+        angle = abs(angle);
+        if(angle > PI) angle = TWO_PI - angle;
+        bool negate = angle > HALF_PI;
+        if(negate) angle = PI - angle;
+
+        // 1 - x^2/2! + x^4/4! - x^6/6! + x^8/8!, evaluated as nested products
+        fixed x2 = angle * angle;
+        fixed result = fixed(1) - x2 / 2 * (fixed(1) - x2 / 12 * (fixed(1) - x2 / 30 * (fixed(1) - x2 / 56)));
+        return negate ? -result : result;
+    }
+};
+
+#endif
\ No newline at end of file
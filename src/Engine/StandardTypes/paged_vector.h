@@ -0,0 +1,159 @@
+#ifndef PAGED_VECTOR_H
+#define PAGED_VECTOR_H
+
+#include "span.h"
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace strb {
+    /**
+     * @brief Vector that allocates its elements in fixed-size pages instead of one contiguous block. Growing never
+     * moves existing elements, so references to them stay valid until that element itself is removed.
+     * Elements are contiguous within a page, which page() exposes.
+     *
+     * @tparam T the element type
+     * @tparam PageSize the number of elements per page. Must be a power of two.
+     */
+    template<typename T, size_t PageSize>
+    class paged_vector {
+        static_assert(PageSize > 0 && (PageSize & (PageSize - 1)) == 0, "PageSize must be a power of two");
+
+    public:
+        paged_vector() = default;
+        paged_vector(const paged_vector&) = delete;
+        paged_vector& operator=(const paged_vector&) = delete;
+
+        ~paged_vector() {
+            clear();
+            for(T* page : _pages) {
+                ::operator delete(page, std::align_val_t(alignof(T)));
+            }
+        }
+
+        void push_back(T value) {
+            if(_size == _pages.size() * PageSize) {
+                _pages.push_back(static_cast<T*>(::operator new(sizeof(T) * PageSize, std::align_val_t(alignof(T)))));
+            }
+            new (slot(_size)) T(std::move(value));
+            ++_size;
+        }
+
+        /**
+         * @brief Removes the last element. Once two trailing pages are empty the last one is freed, so memory
+         * follows the number of elements without reallocating on every push/pop across a page boundary.
+         */
+        void pop_back() {
+            --_size;
+            slot(_size)->~T();
+            if(_pages.size() > 1 && _size + PageSize <= (_pages.size() - 1) * PageSize) {
+                ::operator delete(_pages.back(), std::align_val_t(alignof(T)));
+                _pages.pop_back();
+            }
+        }
+
+        void clear() {
+            while(_size > 0) pop_back();
+        }
+
+        /**
+         * @brief Replaces the contents with copies of other's elements. Pages that are already allocated are
+         * reused, and trivially copyable elements are copied a whole page at a time.
+         */
+        void assign(const paged_vector& other) {
+            if constexpr(std::is_trivially_copyable_v<T>) {
+                reset(other.pageCount());
+                for(size_t page = 0; page < other.pageCount(); ++page) {
+                    size_t start = page * PageSize;
+                    size_t count = (other._size - start < PageSize) ? other._size - start : PageSize;
+                    std::memcpy(_pages[page], other._pages[page], count * sizeof(T));
+                }
+                _size = other._size;
+            }
+            else {
+                assign(other, [](const T& value) -> const T& { return value; });
+            }
+        }
+
+        /**
+         * @brief Replaces the contents with copy(element) for each of other's elements, reusing allocated pages.
+         */
+        template<typename Copy>
+        void assign(const paged_vector& other, Copy copy) {
+            reset(other.pageCount());
+            for(; _size < other._size; ++_size) {
+                new (slot(_size)) T(copy(other[_size]));
+            }
+        }
+
+        T& operator[](size_t index) {
+            return *slot(index);
+        }
+
+        const T& operator[](size_t index) const {
+            return *slot(index);
+        }
+
+        T& back() {
+            return *slot(_size - 1);
+        }
+
+        size_t size() const {
+            return _size;
+        }
+
+        bool empty() const {
+            return _size == 0;
+        }
+
+        size_t pageCount() const {
+            return (_size + PageSize - 1) / PageSize;
+        }
+
+        /**
+         * @brief Gets the number of elements that fit in the pages already allocated.
+         */
+        size_t capacity() const {
+            return _pages.size() * PageSize;
+        }
+
+        /**
+         * @brief Gets the elements stored in one page. Every page but the last is full.
+         */
+        span<T> page(size_t index) {
+            size_t start = index * PageSize;
+            return span<T>(_pages[index], (_size - start < PageSize) ? _size - start : PageSize);
+        }
+
+    private:
+        /**
+         * @brief Destroys every element and keeps exactly the given number of pages (at least one, once any exist).
+         */
+        void reset(size_t pages) {
+            while(_size > 0) {
+                --_size;
+                slot(_size)->~T();
+            }
+            while(_pages.size() < pages) {
+                _pages.push_back(static_cast<T*>(::operator new(sizeof(T) * PageSize, std::align_val_t(alignof(T)))));
+            }
+            while(_pages.size() > pages && _pages.size() > 1) {
+                ::operator delete(_pages.back(), std::align_val_t(alignof(T)));
+                _pages.pop_back();
+            }
+        }
+
+        T* slot(size_t index) const {
+            return _pages[index / PageSize] + index % PageSize;
+        }
+
+        std::vector<T*> _pages;
+        size_t _size = 0;
+    };
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,31 @@
+#ifndef REAL_H
+#define REAL_H
+
+#ifdef FIXED_POINT_SIMULATION
+#include "fixed.h"
+#else
+#include <cmath>
+#endif
+
+namespace strb {
+    /**
+     * @brief Number type used for positions, velocities and timers in the simulation. This is a float unless the game
+     * is built with FIXED_POINT_SIMULATION, in which case it is a fixed so that the simulation is bit-exact across
+     * compilers and machines.
+     *
+     * Code that hands these values to rendering, audio or SDL should cast them explicitly, since fixed only converts
+     * out explicitly.
+     */
+#ifdef FIXED_POINT_SIMULATION
+    using real = fixed;
+#else
+    using real = float;
+    // So that these work on a real in both modes
+    using std::abs;
+    using std::ceil;
+    using std::cos;
+    using std::floor;
+#endif
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,57 @@
+#ifndef SPAN_H
+#define SPAN_H
+
+#include <cstddef>
+
+namespace strb {
+    /**
+     * @brief Non-owning view over a contiguous block of memory. Stand-in for std::span until we move to C++20.
+     * The view is only valid for as long as the memory it points at is.
+     *
+     * @tparam T the element type
+     */
+    template<typename T>
+    class span {
+    public:
+        span() = default;
+        span(T* data, size_t size) : _data(data), _size(size) {}
+
+        T* begin() const {
+            return _data;
+        }
+
+        T* end() const {
+            return _data + _size;
+        }
+
+        T& operator[](size_t index) const {
+            return _data[index];
+        }
+
+        T& front() const {
+            return _data[0];
+        }
+
+        T& back() const {
+            return _data[_size - 1];
+        }
+
+        T* data() const {
+            return _data;
+        }
+
+        size_t size() const {
+            return _size;
+        }
+
+        bool empty() const {
+            return _size == 0;
+        }
+
+    private:
+        T* _data = nullptr;
+        size_t _size = 0;
+    };
+};
+
+#endif
\ No newline at end of file
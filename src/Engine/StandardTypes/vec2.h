@@ -1,10 +1,12 @@
 #ifndef VEC2_H
 #define VEC2_H
 
+#include "real.h"
+
 namespace strb {
     struct vec2 {
         vec2() : x(0.f), y(0.f) {}
-        vec2(float x, float y) : x(x), y(y) {}
+        vec2(real x, real y) : x(x), y(y) {}
 
         vec2 operator+(vec2 const& v) {
             return vec2(x + v.x, y + v.y);
@@ -86,6 +88,28 @@ namespace strb {
             return *this;
         }
 
+#ifdef FIXED_POINT_SIMULATION
+        vec2 operator*(real const& i) {
+            return vec2(x * i, y * i);
+        }
+
+        vec2 operator*=(real const& i) {
+            x *= i;
+            y *= i;
+            return *this;
+        }
+
+        vec2 operator/(real const& i) {
+            return vec2(x / i, y / i);
+        }
+
+        vec2 operator/=(real const& i) {
+            x /= i;
+            y /= i;
+            return *this;
+        }
+#endif
+
         bool operator==(vec2 const& v) {
             return x == v.x && y == v.y;
         }
@@ -94,8 +118,8 @@ namespace strb {
             return x != v.x || y != v.y;
         }
 
-        float x;
-        float y;
+        real x;
+        real y;
     };
 };
 
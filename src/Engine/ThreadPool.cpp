@@ -0,0 +1,70 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(size_t threadCount) {
+    for(size_t i = 0; i < threadCount; ++i) {
+        _workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _jobAvailable.notify_all();
+    for(auto& worker : _workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _jobs.push_back(std::move(job));
+    }
+    _jobAvailable.notify_one();
+}
+
+bool ThreadPool::tryRunJob() {
+    std::function<void()> job;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(_jobs.empty()) return false;
+        job = std::move(_jobs.front());
+        _jobs.pop_front();
+    }
+    job();
+    return true;
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& func) {
+    std::atomic<size_t> remaining = count;
+    for(size_t i = 0; i < count; ++i) {
+        submit([&func, &remaining, i] {
+            func(i);
+            remaining.fetch_sub(1);
+        });
+    }
+    while(remaining.load() > 0) {
+        if(!tryRunJob()) std::this_thread::yield();
+    }
+}
+
+size_t ThreadPool::getThreadCount() const {
+    return _workers.size();
+}
+
+void ThreadPool::workerLoop() {
+    while(true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _jobAvailable.wait(lock, [this] { return _stopping || !_jobs.empty(); });
+            // Jobs still queued when the pool is destroyed are dropped
+            if(_stopping) return;
+            job = std::move(_jobs.front());
+            _jobs.pop_front();
+        }
+        job();
+    }
+}
\ No newline at end of file
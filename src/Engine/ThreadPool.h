@@ -0,0 +1,55 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed set of worker threads that stay alive for the lifetime of the pool and run submitted jobs in
+ * the order they were submitted. The thread that owns the pool can help out with tryRunJob() while it waits.
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Queues a job to be run by the next free thread. Safe to call from inside a job.
+     */
+    void submit(std::function<void()> job);
+
+    /**
+     * @brief Runs one queued job on the calling thread, if there is one.
+     * 
+     * @return True if a job was run
+     */
+    bool tryRunJob();
+
+    /**
+     * @brief Calls func(i) for every i in [0, count), spread over the pool, and returns once every call is done.
+     * The calling thread takes part, so this is safe to call from inside a job.
+     */
+    void parallelFor(size_t count, const std::function<void(size_t)>& func);
+
+    size_t getThreadCount() const;
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> _workers;
+    std::deque<std::function<void()>> _jobs;
+    std::mutex _mutex;
+    std::condition_variable _jobAvailable;
+    bool _stopping = false;
+
+};
+
+#endif
\ No newline at end of file
@@ -1,7 +1,8 @@
 #include "Timer.h"
+#include "real.h"
 
 void Timer::update(float timescale) {
-    _timer -= timescale * 1000.f;
+    _timer = (int) (_timer - strb::real(timescale) * 1000);
     if(_mostRecentSecond != _timer / 1000) {
         _mostRecentSecond = _timer / 1000;
         // play clock tick when there is 3, 2, or 1 secs left
@@ -0,0 +1,10 @@
+#ifndef DORMANT_COMPONENT_H
+#define DORMANT_COMPONENT_H
+
+/**
+ * @brief Tag for entities outside the active region around the camera. They keep their state but skip scripts,
+ * physics and level collisions until the ActivitySystem wakes them up.
+ */
+struct DormantComponent {};
+
+#endif
\ No newline at end of file
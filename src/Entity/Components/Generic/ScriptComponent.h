@@ -2,11 +2,14 @@
 #define SCRIPT_COMPONENT_H
 
 #include "Audio.h"
+#include "ComponentCopy.h"
 
 #include <memory>
 #include <cstdint>
 
-using Entity = std::uint16_t;
+using Entity = std::uint32_t;
+
+class EntityComponentSystem;
 
 class IScript {
 public:
@@ -16,9 +19,22 @@ public:
     /**
      * @brief Update the script.
      * 
+     * @param ecs The world the owner lives in. Scripts are shared between entities, and prototypes between worlds,
+     * so a script must only reach entities through this.
      * @param timescale The timescale to update by - is usually fixed.
      */
-    virtual void update(Entity owner, float timescale, Audio* audio) = 0;
+    virtual void update(EntityComponentSystem* ecs, Entity owner, float timescale, Audio* audio) = 0;
+
+    /**
+     * @brief Copies the script when its ScriptComponent is copied, e.g. for a world snapshot or a new entity made
+     * from a Prototype. Scripts that keep state in member variables must override this to return a copy of
+     * themselves, so that every entity gets its own state and restoring a snapshot restores it.
+     * 
+     * @return The copy, or nullptr if the script has no state and can be shared
+     */
+    virtual std::shared_ptr<IScript> clone() const {
+        return nullptr;
+    }
 
 private:
 
@@ -28,4 +44,12 @@ struct ScriptComponent {
     std::shared_ptr<IScript> script = nullptr;
 };
 
+template<>
+struct ComponentCopy<ScriptComponent> {
+    static ScriptComponent copy(const ScriptComponent& component) {
+        std::shared_ptr<IScript> clone = (component.script != nullptr) ? component.script->clone() : nullptr;
+        return ScriptComponent{(clone != nullptr) ? clone : component.script};
+    }
+};
+
 #endif
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define INPUT_COMPONENT_H
 
 #include "InputEvent.h"
+#include "HeapSize.h"
 
 #include <vector>
 
@@ -9,4 +10,11 @@ struct InputComponent {
     std::vector<InputEvent> allowedInputs;
 };
 
+template<>
+struct HeapSize<InputComponent> {
+    static size_t of(const InputComponent& component) {
+        return heapSize::of(component.allowedInputs);
+    }
+};
+
 #endif
\ No newline at end of file
@@ -11,10 +11,10 @@ struct PhysicsComponent {
 
     bool touchingGround = false;
     int offGroundCount = 0; // Number of frames the entity has been off the ground
-    float jumpPower = 0.f;
-    float frictionCoefficient = 20.f;
-    float airFrictionCoefficient = 5.f;
-    float gravity = 15.f;
+    strb::real jumpPower = 0.f;
+    strb::real frictionCoefficient = 20.f;
+    strb::real airFrictionCoefficient = 5.f;
+    strb::real gravity = 15.f;
 };
 
 #endif
\ No newline at end of file
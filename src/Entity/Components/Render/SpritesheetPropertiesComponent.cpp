@@ -2,7 +2,13 @@
 
 void SpritesheetPropertiesComponent::addSpritesheetProperties(EntityState state, Direction direction, SpritesheetProperties properties) {
     std::string key = std::to_string((int) state) + "-" + std::to_string((int) direction);
-    _propertiesMap[key] = properties;
+    if(_propertiesMap == nullptr) {
+        _propertiesMap = std::make_shared<std::unordered_map<std::string, SpritesheetProperties>>();
+    }
+    else if(_propertiesMap.use_count() > 1) {
+        _propertiesMap = std::make_shared<std::unordered_map<std::string, SpritesheetProperties>>(*_propertiesMap);
+    }
+    (*_propertiesMap)[key] = properties;
 }
 
 void SpritesheetPropertiesComponent::setPrimarySpritesheetProperties(SpritesheetProperties properties) {
@@ -10,10 +16,21 @@ void SpritesheetPropertiesComponent::setPrimarySpritesheetProperties(Spritesheet
 }
 
 SpritesheetProperties SpritesheetPropertiesComponent::getSpritesheetProperties(EntityState state, Direction direction) {
+    if(_propertiesMap == nullptr) return SpritesheetProperties{};
     std::string key = std::to_string((int) state) + "-" + std::to_string((int) direction);
-    return _propertiesMap[key];
+    auto it = _propertiesMap->find(key);
+    return (it != _propertiesMap->end()) ? it->second : SpritesheetProperties{};
 }
 
 SpritesheetProperties SpritesheetPropertiesComponent::getPrimarySpritesheetProperties() {
     return _primarySpritesheetProperties;
+}
+
+size_t SpritesheetPropertiesComponent::getHeapSize() const {
+    if(_propertiesMap == nullptr) return 0;
+    size_t bytes = sizeof(*_propertiesMap) + heapSize::of(*_propertiesMap);
+    for(auto& keyValue : *_propertiesMap) {
+        bytes += heapSize::of(keyValue.first);
+    }
+    return bytes / _propertiesMap.use_count();
 }
\ No newline at end of file
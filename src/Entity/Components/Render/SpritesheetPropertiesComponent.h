@@ -5,7 +5,9 @@
 #include "StateComponent.h"
 #include "DirectionComponent.h"
 #include "Spritesheet.h"
+#include "HeapSize.h"
 
+#include <memory>
 #include <unordered_map>
 
 class SpritesheetPropertiesComponent {
@@ -18,12 +20,26 @@ public:
 
     SpritesheetProperties getSpritesheetProperties(EntityState state, Direction direction);
     SpritesheetProperties getPrimarySpritesheetProperties();
+
+    /**
+     * @brief Gets this component's share of the heap memory held by the properties map, keys included
+     */
+    size_t getHeapSize() const;
     
     Spritesheet* spritesheet = nullptr;
 
 private:
-    std::unordered_map<std::string, SpritesheetProperties> _propertiesMap;
+    // Shared between copies until one of them adds properties, so copying the component (e.g. from a prototype)
+    // doesn't rebuild the map
+    std::shared_ptr<std::unordered_map<std::string, SpritesheetProperties>> _propertiesMap;
     SpritesheetProperties _primarySpritesheetProperties;
 };
 
+template<>
+struct HeapSize<SpritesheetPropertiesComponent> {
+    static size_t of(const SpritesheetPropertiesComponent& component) {
+        return component.getHeapSize();
+    }
+};
+
 #endif
\ No newline at end of file
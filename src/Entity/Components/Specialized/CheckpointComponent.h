@@ -6,6 +6,8 @@
 struct CheckpointComponent {
     std::shared_ptr<IScript> onActivatedScript = nullptr;
     bool isActive = false;
+    // Whether the player was touching the checkpoint at the last check, so activation only fires when they arrive
+    bool isTouchingPlayer = false;
 };
 
 #endif
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define PICKUP_COMPONENT_H
 
 #include "ScriptComponent.h"
+#include "HeapSize.h"
 
 enum class PickupType {
     NOVAL = -1,
@@ -17,4 +18,11 @@ struct PickupComponent {
     PickupType pickupType = PickupType::NOVAL;
 };
 
+template<>
+struct HeapSize<PickupComponent> {
+    static size_t of(const PickupComponent& component) {
+        return heapSize::of(component.onPickupMessage);
+    }
+};
+
 #endif
\ No newline at end of file
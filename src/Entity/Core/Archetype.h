@@ -0,0 +1,334 @@
+#ifndef ARCHETYPE_H
+#define ARCHETYPE_H
+
+#include "EntityConstants.h"
+#include "ComponentTypeRegistry.h"
+#include "ComponentCopy.h"
+#include "HeapSize.h"
+#include "Tag.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+#include <bitset>
+
+using Entity = std::uint32_t;
+using Signature = std::bitset<entityConstants::MAX_COMPONENTS>;
+
+namespace archetypeConstants {
+    // Target bytes per chunk. Rows per chunk are rounded down to a power of two so rows can be located with a shift.
+    const size_t CHUNK_SIZE = 16 * 1024;
+    const size_t CHUNK_ALIGNMENT = 64;
+};
+
+/**
+ * @brief Type-erased description of a component type, so that archetypes can move, copy and destroy components
+ * without knowing their types.
+ */
+struct ComponentInfo {
+    // typeid(T).name(), for EcsStats
+    const char* name = nullptr;
+    size_t size = 0;
+    size_t alignment = 0;
+    // Trivially copyable components are copied into and out of snapshots with memcpy instead of snapshotCopy
+    bool trivial = false;
+    // Tags are part of an archetype's signature but get no column
+    bool tag = false;
+    void (*moveConstruct)(void* destination, void* source) = nullptr;
+    void (*snapshotCopy)(void* destination, const void* source) = nullptr;
+    void (*destroy)(void* component) = nullptr;
+    size_t (*heapSize)(const void* component) = nullptr;
+
+    template<typename T>
+    static ComponentInfo create() {
+        ComponentInfo info;
+        info.name = typeid(T).name();
+        info.size = sizeof(T);
+        info.alignment = alignof(T);
+        info.trivial = std::is_trivially_copyable_v<T>;
+        info.tag = isTag<T>;
+        info.moveConstruct = [](void* destination, void* source) {
+            new (destination) T(std::move(*static_cast<T*>(source)));
+        };
+        info.snapshotCopy = [](void* destination, const void* source) {
+            new (destination) T(ComponentCopy<T>::copy(*static_cast<const T*>(source)));
+        };
+        info.destroy = [](void* component) {
+            static_cast<T*>(component)->~T();
+        };
+        info.heapSize = [](const void* component) {
+            return HeapSize<T>::of(*static_cast<const T*>(component));
+        };
+        return info;
+    }
+};
+
+/**
+ * @brief All entities that share the exact same signature. Rows are stored in fixed-size chunks, with one
+ * tightly packed column per component type (plus one for the entity IDs), so iterating an archetype is a
+ * linear walk over memory. Rows are kept packed by moving the last row into any row that is removed.
+ *
+ * Every column also has a matching array of change versions, stored after all of the component data so that
+ * loops that never look at versions don't pull them into cache.
+ */
+class Archetype {
+public:
+    /**
+     * @param signature The set of components every entity in this archetype has
+     * @param componentInfo Info for every component type, indexed by component type
+     */
+    Archetype(Signature signature, const ComponentInfo* componentInfo) : _signature(signature) {
+        for(size_t i = 0; i < entityConstants::MAX_COMPONENTS; ++i) {
+            _columnOf[i] = -1;
+        }
+
+        size_t rowSize = sizeof(Entity);
+        for(ComponentType type = 0; type < entityConstants::MAX_COMPONENTS; ++type) {
+            if(!signature.test(type) || componentInfo[type].tag) continue;
+            _columnOf[type] = _columns.size();
+            _columns.push_back({type, 0, 0, componentInfo[type]});
+            rowSize += componentInfo[type].size + sizeof(std::uint32_t);
+        }
+
+        _chunkCapacity = 1;
+        while(_chunkCapacity * 2 * rowSize <= archetypeConstants::CHUNK_SIZE) _chunkCapacity *= 2;
+        while((size_t(1) << _chunkShift) < _chunkCapacity) ++_chunkShift;
+
+        // Entity IDs first, then every column one after another, each aligned for its type
+        size_t offset = _chunkCapacity * sizeof(Entity);
+        for(auto& column : _columns) {
+            offset = (offset + column.info.alignment - 1) / column.info.alignment * column.info.alignment;
+            column.offset = offset;
+            offset += _chunkCapacity * column.info.size;
+        }
+        offset = (offset + alignof(std::uint32_t) - 1) / alignof(std::uint32_t) * alignof(std::uint32_t);
+        for(auto& column : _columns) {
+            column.versionOffset = offset;
+            offset += _chunkCapacity * sizeof(std::uint32_t);
+        }
+        _chunkBytes = offset;
+    }
+
+    ~Archetype() {
+        clear();
+        for(auto chunk : _chunks) {
+            ::operator delete(chunk, std::align_val_t(archetypeConstants::CHUNK_ALIGNMENT));
+        }
+    }
+
+    Archetype(const Archetype&) = delete;
+    Archetype& operator=(const Archetype&) = delete;
+
+    /**
+     * @brief Appends a row for the entity. Its components are left unconstructed - the caller must construct
+     * every column of the new row before the archetype is used again.
+     *
+     * @return The new row
+     */
+    size_t addRow(Entity entity) {
+        if(_size == _chunks.size() * _chunkCapacity) {
+            _chunks.push_back(static_cast<std::byte*>(
+                ::operator new(_chunkBytes, std::align_val_t(archetypeConstants::CHUNK_ALIGNMENT))));
+        }
+        size_t row = _size++;
+        setEntity(row, entity);
+        return row;
+    }
+
+    /**
+     * @brief Destroys every component in the row and moves the last row into it.
+     */
+    void removeRow(size_t row) {
+        size_t last = _size - 1;
+        for(auto& column : _columns) {
+            column.info.destroy(getColumnData(column, row));
+            if(row != last) {
+                column.info.moveConstruct(getColumnData(column, row), getColumnData(column, last));
+                column.info.destroy(getColumnData(column, last));
+                getColumnVersion(column, row) = getColumnVersion(column, last);
+            }
+        }
+        if(row != last) setEntity(row, getEntity(last));
+        --_size;
+        if(_chunks.size() > 1 && _size + _chunkCapacity <= (_chunks.size() - 1) * _chunkCapacity) {
+            ::operator delete(_chunks.back(), std::align_val_t(archetypeConstants::CHUNK_ALIGNMENT));
+            _chunks.pop_back();
+        }
+    }
+
+    /**
+     * @brief Destroys every row.
+     */
+    void clear() {
+        while(_size > 0) removeRow(_size - 1);
+    }
+
+    /**
+     * @brief Replaces every row with a copy of other's rows. Other must have the same signature. Columns of
+     * trivially copyable components are copied a chunk at a time, and everything else goes through ComponentCopy.
+     *
+     * @param version The change tick to record every copied component as changed at
+     */
+    void copyFrom(const Archetype& other, std::uint32_t version) {
+        clear();
+        size_t chunks = other.getChunkCount();
+        while(_chunks.size() < chunks) {
+            _chunks.push_back(static_cast<std::byte*>(
+                ::operator new(_chunkBytes, std::align_val_t(archetypeConstants::CHUNK_ALIGNMENT))));
+        }
+        for(size_t chunk = 0; chunk < chunks; ++chunk) {
+            size_t rows = other.getChunkSize(chunk);
+            std::memcpy(_chunks[chunk], other._chunks[chunk], rows * sizeof(Entity));
+            for(size_t column = 0; column < _columns.size(); ++column) {
+                const ComponentInfo& info = _columns[column].info;
+                std::byte* destination = _chunks[chunk] + _columns[column].offset;
+                const std::byte* source = other._chunks[chunk] + other._columns[column].offset;
+                if(info.trivial) {
+                    std::memcpy(destination, source, rows * info.size);
+                }
+                else {
+                    for(size_t row = 0; row < rows; ++row) {
+                        info.snapshotCopy(destination + row * info.size, source + row * info.size);
+                    }
+                }
+                std::fill_n(getChunkVersions(column, chunk), rows, version);
+            }
+        }
+        _size = other._size;
+    }
+
+    /**
+     * @brief Gets the column index of a component type in this archetype.
+     *
+     * @return The column, or -1 if entities in this archetype do not have the component or it is a tag
+     */
+    int getColumn(ComponentType type) const {
+        return _columnOf[type];
+    }
+
+    ComponentType getColumnType(int column) const {
+        return _columns[column].type;
+    }
+
+    size_t getColumnCount() const {
+        return _columns.size();
+    }
+
+    /**
+     * @brief Gets a component by column and row. Column must be valid for this archetype.
+     */
+    void* getComponent(int column, size_t row) {
+        return getColumnData(_columns[column], row);
+    }
+
+    template<typename T>
+    T* getComponent(int column, size_t row) {
+        return static_cast<T*>(getColumnData(_columns[column], row));
+    }
+
+    /**
+     * @brief Gets the change tick the component at the column and row was added or last marked changed at.
+     */
+    std::uint32_t getVersion(int column, size_t row) {
+        return getColumnVersion(_columns[column], row);
+    }
+
+    void setVersion(int column, size_t row, std::uint32_t version) {
+        getColumnVersion(_columns[column], row) = version;
+    }
+
+    /**
+     * @brief Gets the start of a column within a chunk. Rows of the chunk follow contiguously.
+     */
+    template<typename T>
+    T* getChunkColumn(int column, size_t chunk) {
+        return reinterpret_cast<T*>(_chunks[chunk] + _columns[column].offset);
+    }
+
+    /**
+     * @brief Gets the change versions of a column within a chunk, one per row.
+     */
+    std::uint32_t* getChunkVersions(int column, size_t chunk) {
+        return reinterpret_cast<std::uint32_t*>(_chunks[chunk] + _columns[column].versionOffset);
+    }
+
+    Entity* getEntities(size_t chunk) {
+        return reinterpret_cast<Entity*>(_chunks[chunk]);
+    }
+
+    Entity getEntity(size_t row) {
+        return getEntities(row >> _chunkShift)[row & (_chunkCapacity - 1)];
+    }
+
+    /**
+     * @brief Gets the number of rows used in the chunk. Every chunk but the last is full.
+     */
+    size_t getChunkSize(size_t chunk) const {
+        size_t start = chunk * _chunkCapacity;
+        return (_size - start < _chunkCapacity) ? _size - start : _chunkCapacity;
+    }
+
+    size_t getChunkCount() const {
+        return (_size + _chunkCapacity - 1) >> _chunkShift;
+    }
+
+    Signature getSignature() const {
+        return _signature;
+    }
+
+    size_t size() const {
+        return _size;
+    }
+
+    /**
+     * @brief Gets the number of rows that fit in the chunks already allocated.
+     */
+    size_t capacity() const {
+        return _chunks.size() * _chunkCapacity;
+    }
+
+    /**
+     * @brief Cached neighbours in the archetype graph. _addEdges[type] is the archetype reached by adding
+     * the component type to this one, _removeEdges[type] the one reached by removing it.
+     */
+    Archetype* _addEdges[entityConstants::MAX_COMPONENTS] = {};
+    Archetype* _removeEdges[entityConstants::MAX_COMPONENTS] = {};
+
+private:
+    struct Column {
+        ComponentType type;
+        size_t offset;
+        size_t versionOffset;
+        ComponentInfo info;
+    };
+
+    void* getColumnData(const Column& column, size_t row) {
+        return _chunks[row >> _chunkShift] + column.offset + (row & (_chunkCapacity - 1)) * column.info.size;
+    }
+
+    std::uint32_t& getColumnVersion(const Column& column, size_t row) {
+        return reinterpret_cast<std::uint32_t*>(_chunks[row >> _chunkShift] + column.versionOffset)[row & (_chunkCapacity - 1)];
+    }
+
+    void setEntity(size_t row, Entity entity) {
+        getEntities(row >> _chunkShift)[row & (_chunkCapacity - 1)] = entity;
+    }
+
+    Signature _signature;
+    std::vector<Column> _columns;
+    std::int8_t _columnOf[entityConstants::MAX_COMPONENTS];
+    std::vector<std::byte*> _chunks;
+    size_t _chunkCapacity = 1;
+    size_t _chunkShift = 0;
+    size_t _chunkBytes = 0;
+    size_t _size = 0;
+
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,377 @@
+#ifndef ARCHETYPE_COMPONENT_MANAGER_H
+#define ARCHETYPE_COMPONENT_MANAGER_H
+
+#include "EntityConstants.h"
+#include "ComponentTypeRegistry.h"
+#include "EntityHandle.h"
+#include "Archetype.h"
+#include "Tag.h"
+#include "EcsStats.h"
+#include "span.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+#include <iostream>
+
+class EntityManager;
+
+/**
+ * @brief Drop-in replacement for ComponentManager that groups entities by signature. Every entity lives in
+ * exactly one Archetype, and all of its components sit in the same row of that archetype's chunks. Adding or
+ * removing a component moves the entity's row to another archetype.
+ *
+ * Tags are part of the archetype signatures but have no column, so they take no space in the chunks.
+ *
+ * Note that a reference to a component is invalidated by adding or removing components on its entity, and by
+ * destroying any other entity in the same archetype.
+ */
+class ArchetypeComponentManager {
+public:
+    /**
+     * @param entityManager Unused, since tags are read from the archetype signatures. Taken so both storages are
+     * created the same way.
+     */
+    explicit ArchetypeComponentManager(const EntityManager* entityManager = nullptr) {}
+    ~ArchetypeComponentManager() = default;
+
+    template<typename T>
+    T& getComponent(Entity entity) {
+        if constexpr(isTag<T>) {
+            return tagInstance<T>();
+        }
+        else {
+            T* component = tryGetComponent<T>(entity);
+            if(component != nullptr) return *component;
+            return defaultValue<T>();
+        }
+    }
+
+    /**
+     * @brief Gets the entity's component if it has one.
+     *
+     * @return Pointer to the component, or nullptr if the entity does not have it
+     */
+    template<typename T>
+    T* tryGetComponent(Entity entity) {
+        if constexpr(isTag<T>) {
+            return hasComponent<T>(entity) ? &tagInstance<T>() : nullptr;
+        }
+        else {
+            EntityLocation* location = getLocation(entity);
+            if(location == nullptr) return nullptr;
+            int column = location->archetype->getColumn(getComponentType<T>());
+            if(column == -1) return nullptr;
+            return location->archetype->getComponent<T>(column, location->row);
+        }
+    }
+
+    template<typename T>
+    ComponentType getComponentType() {
+        return ComponentTypeRegistry::getType<T>();
+    }
+
+    /**
+     * @brief Collects every entity that owns the component. Unlike the sparse set storage this walks every
+     * matching archetype, so prefer views in anything that runs every frame.
+     *
+     * @return View of the collected entities, valid until the next call for the same component
+     */
+    template<typename T>
+    strb::span<const Entity> getAllOf() {
+        ComponentType type = getComponentType<T>();
+        std::vector<Entity>& entities = _allOf[type];
+        entities.clear();
+        for(auto& archetype : _archetypes) {
+            if(!archetype->getSignature().test(type)) continue;
+            for(size_t row = 0; row < archetype->size(); ++row) {
+                entities.push_back(archetype->getEntity(row));
+            }
+        }
+        return strb::span<const Entity>(entities.data(), entities.size());
+    }
+
+    template<typename T>
+    bool hasComponent(Entity entity) {
+        EntityLocation* location = getLocation(entity);
+        if(location == nullptr) return false;
+        return location->archetype->getSignature().test(getComponentType<T>());
+    }
+
+    template<typename T>
+    void addComponent(Entity entity, T component) {
+        if(entity == entityConstants::NULL_ENTITY) return;
+        registerComponent<T>();
+        ComponentType type = getComponentType<T>();
+        std::uint32_t slot = entityHandle::getIndex(entity);
+        if(slot >= _locations.size()) _locations.resize(slot + 1);
+
+        // A slot in use by a different handle means this handle is stale
+        Archetype* source = _locations[slot].archetype;
+        if(source != nullptr && (_locations[slot].entity != entity || source->getSignature().test(type))) return;
+
+        Archetype* destination = getNextArchetype(source, type, true);
+        size_t row = moveEntity(entity, destination);
+        constructComponent(destination, row, std::move(component), getChangeTick());
+    }
+
+    /**
+     * @brief Adds several components to the entity in one call. An entity with no components yet is placed straight
+     * into the archetype for the whole set, instead of moving through one archetype per component. Each type may
+     * only be listed once.
+     */
+    template<typename... Ts>
+    void addComponents(Entity entity, Ts... components) {
+        if(entity == entityConstants::NULL_ENTITY) return;
+        (registerComponent<Ts>(), ...);
+        std::uint32_t slot = entityHandle::getIndex(entity);
+        if(slot < _locations.size() && _locations[slot].archetype != nullptr) {
+            (addComponent<Ts>(entity, std::move(components)), ...);
+            return;
+        }
+        if(slot >= _locations.size()) _locations.resize(slot + 1);
+
+        Signature signature;
+        (signature.set(getComponentType<Ts>()), ...);
+        Archetype* destination = getArchetype(signature);
+        size_t row = moveEntity(entity, destination);
+        std::uint32_t tick = getChangeTick();
+        (constructComponent(destination, row, std::move(components), tick), ...);
+    }
+
+    template<typename T>
+    void removeComponent(Entity entity) {
+        if(!hasComponent<T>(entity)) return;
+        Archetype* destination = getNextArchetype(getLocation(entity)->archetype, getComponentType<T>(), false);
+        moveEntity(entity, destination);
+    }
+
+    template<typename T>
+    void markChanged(Entity entity) {
+        EntityLocation* location = getLocation(entity);
+        if(location == nullptr) return;
+        int column = location->archetype->getColumn(getComponentType<T>());
+        if(column != -1) location->archetype->setVersion(column, location->row, getChangeTick());
+    }
+
+    std::uint32_t getChangeTick() const {
+        return _changeTick.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @return The change tick from before the call
+     */
+    std::uint32_t advanceChangeTick() {
+        return _changeTick.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Destroys all of the entity's components and frees its row.
+     */
+    void entityDestroyed(Entity entity, Signature signature) {
+        if(getLocation(entity) == nullptr) return;
+        moveEntity(entity, nullptr);
+    }
+
+    /**
+     * @brief Replaces every entity and component with a copy of other's. Archetypes other has that this manager
+     * does not are created, and archetypes it has that other leaves empty are cleared, so pointers to archetypes
+     * stay valid. Copied components are recorded as changed at the current change tick.
+     */
+    void copyFrom(const ArchetypeComponentManager& other) {
+        std::uint32_t tick = getChangeTick();
+        for(ComponentType type = 0; type < entityConstants::MAX_COMPONENTS; ++type) {
+            if(other._componentInfo[type].size != 0) _componentInfo[type] = other._componentInfo[type];
+        }
+        for(auto& archetype : _archetypes) {
+            archetype->clear();
+        }
+        for(auto& source : other._archetypes) {
+            if(source->size() > 0) getArchetype(source->getSignature())->copyFrom(*source, tick);
+        }
+        _locations = other._locations;
+        for(auto& location : _locations) {
+            if(location.archetype != nullptr) location.archetype = getArchetype(location.archetype->getSignature());
+        }
+    }
+
+    /**
+     * @brief Adds the stats of every component type that has been used so far, in component type order, leaving
+     * out tags since they take no memory. A type's numbers are totals over every archetype that has it, and its
+     * reserved bytes include the change versions stored with it, but not the entity IDs each chunk also holds.
+     */
+    void getStats(std::vector<ComponentStats>& stats) {
+        for(ComponentType type = 0; type < entityConstants::MAX_COMPONENTS; ++type) {
+            const ComponentInfo& info = _componentInfo[type];
+            if(info.size == 0 || info.tag) continue;
+            ComponentStats componentStats;
+            componentStats.type = type;
+            componentStats.name = EcsStats::typeName(info.name);
+            componentStats.size = info.size;
+            for(auto& archetype : _archetypes) {
+                int column = archetype->getColumn(type);
+                if(column == -1) continue;
+                componentStats.count += archetype->size();
+                componentStats.capacity += archetype->capacity();
+                componentStats.reservedBytes += archetype->capacity() * (info.size + sizeof(std::uint32_t));
+                for(size_t row = 0; row < archetype->size(); ++row) {
+                    componentStats.heapBytes += info.heapSize(archetype->getComponent(column, row));
+                }
+            }
+            stats.push_back(componentStats);
+        }
+    }
+
+    /**
+     * @brief Gets every archetype created so far, in creation order. Archetypes are never destroyed, so
+     * pointers to them stay valid for the lifetime of the manager.
+     */
+    const std::vector<std::unique_ptr<Archetype>>& getArchetypes() const {
+        return _archetypes;
+    }
+
+private:
+    struct EntityLocation {
+        Archetype* archetype = nullptr;
+        size_t row = 0;
+        // Full handle of the entity in the slot, to tell it apart from stale handles with the same index
+        Entity entity = entityConstants::NULL_ENTITY;
+    };
+
+    /**
+     * @return The entity's location, or nullptr if it has no components or the handle is stale
+     */
+    EntityLocation* getLocation(Entity entity) {
+        std::uint32_t slot = entityHandle::getIndex(entity);
+        if(slot >= _locations.size()) return nullptr;
+        EntityLocation& location = _locations[slot];
+        if(location.archetype == nullptr || location.entity != entity) return nullptr;
+        return &location;
+    }
+
+    /**
+     * @brief Records how to move and destroy the component type the first time it is added.
+     */
+    template<typename T>
+    void registerComponent() {
+        ComponentType type = getComponentType<T>();
+        if(_componentInfo[type].size == 0) {
+            _componentInfo[type] = ComponentInfo::create<T>();
+        }
+    }
+
+    /**
+     * @brief Constructs the component in the entity's new row. Tags have no column, so there is nothing to do.
+     */
+    template<typename T>
+    void constructComponent(Archetype* archetype, size_t row, T component, std::uint32_t version) {
+        if constexpr(!isTag<T>) {
+            int column = archetype->getColumn(getComponentType<T>());
+            new (archetype->getComponent(column, row)) T(std::move(component));
+            archetype->setVersion(column, row, version);
+        }
+    }
+
+    /**
+     * @brief Follows (and caches) the archetype graph edge for adding or removing a component type.
+     *
+     * @return The neighbouring archetype, or nullptr if it would have no components
+     */
+    Archetype* getNextArchetype(Archetype* source, ComponentType type, bool add) {
+        Archetype*& edge = (source == nullptr) ? _rootEdges[type] :
+            (add ? source->_addEdges[type] : source->_removeEdges[type]);
+        if(edge != nullptr) return edge;
+
+        Signature signature = (source == nullptr) ? Signature() : source->getSignature();
+        signature.set(type, add);
+        if(signature.none()) return nullptr;
+
+        edge = getArchetype(signature);
+        return edge;
+    }
+
+    /**
+     * @brief Gets the archetype for the signature, creating it if this is the first entity with that signature.
+     */
+    Archetype* getArchetype(Signature signature) {
+        auto it = _archetypeLookup.find(signature);
+        if(it != _archetypeLookup.end()) return it->second;
+        _archetypes.push_back(std::make_unique<Archetype>(signature, _componentInfo));
+        Archetype* archetype = _archetypes.back().get();
+        _archetypeLookup[signature] = archetype;
+        return archetype;
+    }
+
+    /**
+     * @brief Moves the entity's row into the destination archetype, carrying over every component both archetypes
+     * share. Components the destination does not have are destroyed, and components only the destination has are
+     * left for the caller to construct.
+     *
+     * @param destination The archetype to move into, or nullptr to remove the entity's row entirely
+     * @return The entity's row in the destination archetype
+     */
+    size_t moveEntity(Entity entity, Archetype* destination) {
+        EntityLocation& location = _locations[entityHandle::getIndex(entity)];
+        Archetype* source = location.archetype;
+        size_t row = 0;
+
+        if(destination != nullptr) {
+            row = destination->addRow(entity);
+            if(source != nullptr) {
+                for(size_t column = 0; column < source->getColumnCount(); ++column) {
+                    ComponentType type = source->getColumnType(column);
+                    int destinationColumn = destination->getColumn(type);
+                    if(destinationColumn != -1) {
+                        _componentInfo[type].moveConstruct(destination->getComponent(destinationColumn, row),
+                            source->getComponent(column, location.row));
+                        destination->setVersion(destinationColumn, row, source->getVersion(column, location.row));
+                    }
+                }
+            }
+        }
+
+        if(source != nullptr) {
+            source->removeRow(location.row);
+            if(location.row < source->size()) {
+                _locations[entityHandle::getIndex(source->getEntity(location.row))].row = location.row;
+            }
+        }
+
+        location.archetype = destination;
+        location.row = row;
+        location.entity = entity;
+        return row;
+    }
+
+    /**
+     * @brief Value returned by getComponent() for entities without the component. Created the first time it is
+     * needed and kept per manager, so that separate worlds never write into each other's fallback.
+     *
+     * @return Default T value
+     */
+    template<typename T>
+    T& defaultValue() {
+        ComponentType type = getComponentType<T>();
+        std::lock_guard<std::mutex> lock(_defaultsMutex);
+        if(_defaults[type] == nullptr) _defaults[type] = std::make_shared<T>();
+        return *static_cast<T*>(_defaults[type].get());
+    }
+
+    std::vector<EntityLocation> _locations;
+    std::vector<std::unique_ptr<Archetype>> _archetypes;
+    std::unordered_map<Signature, Archetype*> _archetypeLookup;
+    // Edges out of the empty signature, which has no archetype of its own
+    Archetype* _rootEdges[entityConstants::MAX_COMPONENTS] = {};
+    ComponentInfo _componentInfo[entityConstants::MAX_COMPONENTS];
+    std::vector<Entity> _allOf[entityConstants::MAX_COMPONENTS];
+    std::shared_ptr<void> _defaults[entityConstants::MAX_COMPONENTS];
+    std::mutex _defaultsMutex;
+    // Starts above 0 so that every component counts as changed since tick 0
+    std::atomic<std::uint32_t> _changeTick = 1;
+
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,292 @@
+#ifndef ARCHETYPE_VIEW_H
+#define ARCHETYPE_VIEW_H
+
+#include "ArchetypeComponentManager.h"
+#include "View.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+template<typename Exclude, typename... Ts>
+class BasicArchetypeView;
+
+/**
+ * @brief View for the archetype storage. Same interface and iteration rules as BasicView, but instead of
+ * checking entities one at a time it picks out the archetypes whose signature matches once, up front, and
+ * then walks their chunks linearly.
+ *
+ * Tags only take part in matching signatures; every entity that has one gets the shared tag instance.
+ *
+ * Archetypes created after the view are not visited.
+ *
+ * @tparam Excluded the components an entity must not have
+ * @tparam Ts the components an entity must have. Each type may only be listed once.
+ */
+template<typename... Excluded, typename... Ts>
+class BasicArchetypeView<ExcludeList<Excluded...>, Ts...> {
+    static_assert(sizeof...(Ts) > 0, "A view must include at least one component");
+
+public:
+    class Iterator {
+    public:
+        Iterator(BasicArchetypeView* view, size_t archetype) : _view(view), _archetype(archetype) {
+            if(_archetype > 0) loadArchetype();
+            seek();
+        }
+
+        /**
+         * @return The entity followed by a reference to each included component, in the order they were listed
+         */
+        std::tuple<Entity, Ts&...> operator*() const {
+            return get(std::index_sequence_for<Ts...>{});
+        }
+
+        Iterator& operator++() {
+            --_row;
+            seek();
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return _archetype == other._archetype && _row == other._row;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        template<size_t... Is>
+        std::tuple<Entity, Ts&...> get(std::index_sequence<Is...>) const {
+            size_t row = _row - 1;
+            return std::tuple<Entity, Ts&...>(_current->getEntity(row), getComponent<Ts>(_current, _columns[Is], row)...);
+        }
+
+        // Caches the archetype the iterator is now in, so its columns are only looked up once
+        void loadArchetype() {
+            _current = _view->_archetypes[_archetype - 1];
+            _row = _current->size();
+            size_t i = 0;
+            ((_columns[i++] = _current->getColumn(ComponentTypeRegistry::getType<Ts>())), ...);
+        }
+
+        // Moves on to the previous archetype whenever the current one runs out of rows, and skips rows that
+        // fail the change filter
+        void seek() {
+            while(_archetype > 0) {
+                if(_row == 0) {
+                    --_archetype;
+                    if(_archetype > 0) loadArchetype();
+                }
+                else if(!_view->_filterChanged || _view->hasChanged(_current, _columns, _row - 1)) {
+                    return;
+                }
+                else {
+                    --_row;
+                }
+            }
+        }
+
+        BasicArchetypeView* _view = nullptr;
+        Archetype* _current = nullptr;
+        size_t _archetype = 0;
+        size_t _row = 0;
+        int _columns[sizeof...(Ts)] = {};
+    };
+
+    explicit BasicArchetypeView(ArchetypeComponentManager* componentManager) : _componentManager(componentManager) {
+        Signature include, exclude;
+        (include.set(ComponentTypeRegistry::getType<Ts>()), ...);
+        (exclude.set(ComponentTypeRegistry::getType<Excluded>()), ...);
+        for(auto& archetype : componentManager->getArchetypes()) {
+            Signature signature = archetype->getSignature();
+            if((signature & include) == include && (signature & exclude).none()) {
+                _archetypes.push_back(archetype.get());
+            }
+        }
+    }
+
+    /**
+     * @brief Creates a copy of this view that also skips entities owning any of the given components.
+     *
+     * @return The filtered view
+     */
+    template<typename... Us>
+    BasicArchetypeView<ExcludeList<Excluded..., Us...>, Ts...> exclude() const {
+        BasicArchetypeView<ExcludeList<Excluded..., Us...>, Ts...> view(_componentManager);
+        view._filterChanged = _filterChanged;
+        view._changedSince = _changedSince;
+        std::copy(std::begin(_changedFilter), std::end(_changedFilter), std::begin(view._changedFilter));
+        return view;
+    }
+
+    /**
+     * @brief Creates a copy of this view that only visits entities where at least one of the given components was
+     * added or marked changed after the tick. Same rules as BasicView::changed().
+     *
+     * @return The filtered view
+     */
+    template<typename... Us>
+    BasicArchetypeView changed(std::uint32_t tick) const {
+        static_assert(((viewDetail::indexOf<Us, Ts...>() < sizeof...(Ts)) && ...), "Only included components can be checked for changes");
+        static_assert(!(isTag<Us> || ...), "Tags can't be checked for changes");
+        BasicArchetypeView view = *this;
+        view._filterChanged = true;
+        view._changedSince = tick;
+        ((view._changedFilter[viewDetail::indexOf<Us, Ts...>()] = true), ...);
+        return view;
+    }
+
+    /**
+     * @brief Calls func(entity, components...) for every entity in the view. Same order and rules as a range-for,
+     * but each chunk's columns are looked up once and then indexed directly.
+     */
+    template<typename Func>
+    void each(Func func) {
+        for(size_t a = _archetypes.size(); a-- > 0;) {
+            Archetype* archetype = _archetypes[a];
+            int columns[] = {archetype->getColumn(ComponentTypeRegistry::getType<Ts>())...};
+            for(size_t chunk = archetype->getChunkCount(); chunk-- > 0;) {
+                eachInChunk(archetype, chunk, columns, func, std::index_sequence_for<Ts...>{});
+            }
+        }
+    }
+
+    /**
+     * @brief Calls func(batch, entity, components...) for every entity, running batches in parallel on the pool. Same
+     * rules as BasicView::parallelEach(), except that each chunk is one batch since chunks already have a fixed size,
+     * so batchSize is ignored.
+     */
+    template<typename Func>
+    void parallelEach(ThreadPool* pool, size_t batchSize, Func func) {
+        std::vector<std::pair<Archetype*, size_t>> chunks;
+        for(auto archetype : _archetypes) {
+            for(size_t chunk = 0; chunk < archetype->getChunkCount(); ++chunk) {
+                chunks.push_back({archetype, chunk});
+            }
+        }
+        auto runBatch = [this, &chunks, &func](size_t batch) {
+            Archetype* archetype = chunks[batch].first;
+            int columns[] = {archetype->getColumn(ComponentTypeRegistry::getType<Ts>())...};
+            auto batchFunc = [batch, &func](Entity entity, Ts&... components) {
+                func(batch, entity, components...);
+            };
+            eachInChunk(archetype, chunks[batch].second, columns, batchFunc, std::index_sequence_for<Ts...>{});
+        };
+        if(pool == nullptr || pool->getThreadCount() == 0 || chunks.size() < 2) {
+            for(size_t batch = chunks.size(); batch-- > 0;) runBatch(batch);
+        }
+        else {
+            pool->parallelFor(chunks.size(), runBatch);
+        }
+    }
+
+    /**
+     * @return The number of batches parallelEach() splits the view into
+     */
+    size_t batchCount(size_t batchSize) const {
+        size_t chunks = 0;
+        for(auto archetype : _archetypes) chunks += archetype->getChunkCount();
+        return chunks;
+    }
+
+    Iterator begin() {
+        return Iterator(this, _archetypes.size());
+    }
+
+    Iterator end() {
+        return Iterator(this, 0);
+    }
+
+    /**
+     * @brief Gets the number of entities currently in the matching archetypes.
+     *
+     * @return Number of entities that will be visited
+     */
+    size_t sizeHint() const {
+        size_t size = 0;
+        for(auto archetype : _archetypes) size += archetype->size();
+        return size;
+    }
+
+private:
+    template<typename, typename...>
+    friend class BasicArchetypeView;
+
+    /**
+     * @brief Tags have no column, so every row gets the shared tag instance.
+     */
+    template<typename T>
+    static T& getComponent(Archetype* archetype, int column, size_t row) {
+        if constexpr(isTag<T>) {
+            return tagInstance<T>();
+        }
+        else {
+            return *archetype->template getComponent<T>(column, row);
+        }
+    }
+
+    /**
+     * @return The start of the component's column in the chunk, or nullptr for tags
+     */
+    template<typename T>
+    static T* getChunkColumn(Archetype* archetype, int column, size_t chunk) {
+        if constexpr(isTag<T>) {
+            return nullptr;
+        }
+        else {
+            return archetype->template getChunkColumn<T>(column, chunk);
+        }
+    }
+
+    template<typename T>
+    static T& getAt(T* column, size_t i) {
+        if constexpr(isTag<T>) {
+            return tagInstance<T>();
+        }
+        else {
+            return column[i];
+        }
+    }
+
+    template<typename Func, size_t... Is>
+    void eachInChunk(Archetype* archetype, size_t chunk, const int* columns, Func& func, std::index_sequence<Is...>) {
+        Entity* entities = archetype->getEntities(chunk);
+        std::tuple<Ts*...> data(getChunkColumn<Ts>(archetype, columns[Is], chunk)...);
+        if(!_filterChanged) {
+            for(size_t i = archetype->getChunkSize(chunk); i-- > 0;) {
+                func(entities[i], getAt<Ts>(std::get<Is>(data), i)...);
+            }
+            return;
+        }
+        const std::uint32_t* versions[] = {(isTag<Ts> ? nullptr : archetype->getChunkVersions(columns[Is], chunk))...};
+        for(size_t i = archetype->getChunkSize(chunk); i-- > 0;) {
+            if((false || ... || (_changedFilter[Is] && versions[Is][i] > _changedSince))) {
+                func(entities[i], getAt<Ts>(std::get<Is>(data), i)...);
+            }
+        }
+    }
+
+    bool hasChanged(Archetype* archetype, const int* columns, size_t row) const {
+        for(size_t i = 0; i < sizeof...(Ts); ++i) {
+            if(_changedFilter[i] && archetype->getVersion(columns[i], row) > _changedSince) return true;
+        }
+        return false;
+    }
+
+    ArchetypeComponentManager* _componentManager = nullptr;
+    std::vector<Archetype*> _archetypes;
+    /**
+     * @brief Set by changed(). Which included components to check, and the tick they must have changed after.
+     */
+    bool _filterChanged = false;
+    bool _changedFilter[sizeof...(Ts)] = {};
+    std::uint32_t _changedSince = 0;
+
+};
+
+#endif
\ No newline at end of file
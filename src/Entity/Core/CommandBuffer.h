@@ -0,0 +1,77 @@
+#ifndef COMMAND_BUFFER_H
+#define COMMAND_BUFFER_H
+
+#include "EntityManager.h"
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+class EntityComponentSystem;
+
+/**
+ * @brief Records structural changes (destroying entities, adding and removing components) so that they can be
+ * made while iterating views and system entity lists. Nothing is applied until EntityComponentSystem::flushCommands()
+ * is called, and then every command runs in the order it was recorded.
+ *
+ * Entities created through the buffer get their handle straight away, since an entity with no components is not
+ * visible to any view or system. Their components are added at the flush like any other.
+ */
+class CommandBuffer {
+public:
+    /**
+     * @brief A single recorded change. Destroy commands have no apply function.
+     */
+    struct Command {
+        Entity entity;
+        std::function<void(EntityComponentSystem&)> apply;
+    };
+
+    explicit CommandBuffer(EntityManager* entityManager) : _entityManager(entityManager) {}
+
+    /**
+     * @return The new entity's handle, or entityConstants::NULL_ENTITY if no more entities can be created
+     */
+    Entity createEntity() {
+        return _entityManager->createEntity();
+    }
+
+    void destroyEntity(Entity entity) {
+        _commands.push_back({entity, nullptr});
+    }
+
+    template<typename T>
+    void addComponent(Entity entity, T component) {
+        _commands.push_back({entity, [entity, component = std::move(component)](auto& ecs) mutable {
+            ecs.template applyAddComponent<T>(entity, std::move(component));
+        }});
+    }
+
+    template<typename T>
+    void removeComponent(Entity entity) {
+        _commands.push_back({entity, [entity](auto& ecs) {
+            ecs.template applyRemoveComponent<T>(entity);
+        }});
+    }
+
+    bool empty() const {
+        return _commands.empty();
+    }
+
+    /**
+     * @brief Hands over every recorded command and leaves the buffer empty, so commands recorded while the
+     * returned ones are being applied wait for the next flush.
+     */
+    std::vector<Command> take() {
+        std::vector<Command> commands;
+        commands.swap(_commands);
+        return commands;
+    }
+
+private:
+    EntityManager* _entityManager = nullptr;
+    std::vector<Command> _commands;
+
+};
+
+#endif
\ No newline at end of file
@@ -3,116 +3,304 @@
 
 #include "IComponentArray.h"
 #include "EntityConstants.h"
+#include "EntityHandle.h"
+#include "span.h"
+#include "paged_vector.h"
+#include "ComponentCopy.h"
+#include "HeapSize.h"
 
-#include <list>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
 
 /**
- * @brief ComponentArray class to keep track of all entity's components.
+ * @brief ComponentArray class to keep track of all entity's components. This is a sparse set: a paged
+ * entity -> index lookup, plus packed arrays of the entities and their components. Lookup pages are only
+ * allocated for ranges of entity IDs that are actually used, and packed storage grows a page at a time,
+ * so memory follows the number of live components rather than the highest possible entity ID.
  * 
+ * The lookup is keyed by the entity's slot index, and the packed entity array holds full handles. Every lookup
+ * compares the two, so a stale handle to a destroyed entity never reaches the component of whatever reused its slot.
+ *
+ * Each component also carries a change version: the change tick it was added or last marked changed at. Versions
+ * sit in their own packed array alongside the components, so they are only read by views that filter on changes.
+ *
  * @tparam the generic component type
  */
 template<typename T>
 class ComponentArray : public IComponentArray {
 public:
-    ComponentArray() {
-        for(size_t i = 0; i < entityConstants::MAX_ENTITIES; ++i) {
-            _entityToIndexMap[i] = -1;
-            _indexToEntityMap[i] = -1;
+    ComponentArray() = default;
+
+    ~ComponentArray() {
+        for(std::uint32_t* page : _entityToIndexMap) {
+            if(page != emptyPage()) delete[] page;
         }
     }
-    ~ComponentArray() = default;
+
+    ComponentArray(const ComponentArray&) = delete;
+    ComponentArray& operator=(const ComponentArray&) = delete;
 
     void entityDestroyed(Entity entity) override {
-        if(entity < entityConstants::MAX_ENTITIES) {
-            if(_entityToIndexMap[entity] != -1) {
-                removeData(entity);
+        removeData(entity);
+    }
+
+    std::unique_ptr<IComponentArray> createEmpty() const override {
+        return std::make_unique<ComponentArray<T>>();
+    }
+
+    /**
+     * @brief Copies the packed arrays and lookup pages from other. Trivially copyable components are copied a page
+     * at a time, and everything else goes through ComponentCopy.
+     */
+    void copyFrom(const IComponentArray& otherArray, std::uint32_t version) override {
+        const ComponentArray& other = static_cast<const ComponentArray&>(otherArray);
+        if constexpr(std::is_trivially_copyable_v<T>) {
+            _componentArray.assign(other._componentArray);
+        }
+        else {
+            _componentArray.assign(other._componentArray, ComponentCopy<T>::copy);
+        }
+        _indexToEntityMap = other._indexToEntityMap;
+        _versions.assign(other._versions.size(), version);
+
+        size_t pages = std::max(_entityToIndexMap.size(), other._entityToIndexMap.size());
+        for(size_t page = 0; page < pages; ++page) {
+            bool empty = page >= other._entityToIndexMap.size() || other._entityToIndexMap[page] == emptyPage();
+            if(empty) {
+                if(page < _entityToIndexMap.size() && _entityToIndexMap[page] != emptyPage()) {
+                    std::fill_n(_entityToIndexMap[page], entityConstants::SPARSE_PAGE_SIZE, NO_INDEX);
+                }
+                continue;
             }
+            if(page >= _entityToIndexMap.size()) _entityToIndexMap.resize(page + 1, emptyPage());
+            if(_entityToIndexMap[page] == emptyPage()) {
+                _entityToIndexMap[page] = new std::uint32_t[entityConstants::SPARSE_PAGE_SIZE];
+            }
+            std::memcpy(_entityToIndexMap[page], other._entityToIndexMap[page],
+                entityConstants::SPARSE_PAGE_SIZE * sizeof(std::uint32_t));
         }
     }
 
-    void insertData(Entity entity, T component) {
-        if(entity < entityConstants::MAX_ENTITIES && _entityToIndexMap[entity] == -1) {
-            size_t index = _size;
-            _entityToIndexMap[entity] = index;
-            _indexToEntityMap[index] = entity;
-            _componentArray[index] = component;
-            _componentEntityPool.push_back(entity);
-            ++_size;
+    void clear() override {
+        _componentArray.clear();
+        _indexToEntityMap.clear();
+        _versions.clear();
+        for(std::uint32_t* page : _entityToIndexMap) {
+            if(page != emptyPage()) std::fill_n(page, entityConstants::SPARSE_PAGE_SIZE, NO_INDEX);
         }
     }
 
+    ComponentStats getStats() const override {
+        ComponentStats stats;
+        stats.type = ComponentTypeRegistry::getType<T>();
+        stats.name = EcsStats::typeName(typeid(T).name());
+        stats.size = sizeof(T);
+        stats.count = size();
+        stats.capacity = _componentArray.capacity();
+        stats.reservedBytes = _componentArray.capacity() * sizeof(T) + _indexToEntityMap.capacity() * sizeof(Entity) +
+            _versions.capacity() * sizeof(std::uint32_t) + _entityToIndexMap.capacity() * sizeof(std::uint32_t*);
+        for(std::uint32_t* page : _entityToIndexMap) {
+            if(page != emptyPage()) stats.reservedBytes += entityConstants::SPARSE_PAGE_SIZE * sizeof(std::uint32_t);
+        }
+        for(size_t i = 0; i < _componentArray.size(); ++i) {
+            stats.heapBytes += HeapSize<T>::of(_componentArray[i]);
+        }
+        return stats;
+    }
+
+    /**
+     * @param version The change tick to record the new component as changed at
+     */
+    void insertData(Entity entity, T component, std::uint32_t version) {
+        if(entity == entityConstants::NULL_ENTITY) return;
+        std::uint32_t& index = getOrCreateIndex(entity);
+        // Already taken if the entity has the component, or if the handle is stale and a newer entity holds the slot
+        if(index == NO_INDEX) {
+            index = _indexToEntityMap.size();
+            _indexToEntityMap.push_back(entity);
+            _componentArray.push_back(std::move(component));
+            _versions.push_back(version);
+        }
+    }
+
+    /**
+     * @brief Removes the entity's component by moving the last element into its slot, so the array stays packed.
+     * Note that this reorders the packed array - loops that remove while iterating should walk it back to front.
+     */
     void removeData(Entity entity) {
-        if(entity < entityConstants::MAX_ENTITIES) {
-            size_t oldIndex = _entityToIndexMap[entity];
-            _componentArray[oldIndex] = _componentArray[_size - 1];
-
-            int entityOfLastElement = _indexToEntityMap[_size - 1];
-            _entityToIndexMap[entityOfLastElement] = oldIndex;
-            _indexToEntityMap[oldIndex] = entityOfLastElement;
-
-            _entityToIndexMap[entity] = -1;
-            _indexToEntityMap[_size - 1] = -1;
-            for(auto it = _componentEntityPool.begin(); it != _componentEntityPool.end(); ++it) {
-                if(*it == entity) {
-                    _componentEntityPool.erase(it);
-                    break;
-                }
+        std::uint32_t oldIndex = getIndex(entity);
+        if(oldIndex != NO_INDEX) {
+            std::uint32_t lastIndex = _indexToEntityMap.size() - 1;
+            if(oldIndex != lastIndex) {
+                _componentArray[oldIndex] = std::move(_componentArray.back());
+                _versions[oldIndex] = _versions.back();
+
+                Entity entityOfLastElement = _indexToEntityMap[lastIndex];
+                getOrCreateIndex(entityOfLastElement) = oldIndex;
+                _indexToEntityMap[oldIndex] = entityOfLastElement;
             }
-            --_size;
+
+            getOrCreateIndex(entity) = NO_INDEX;
+            _componentArray.pop_back();
+            _indexToEntityMap.pop_back();
+            _versions.pop_back();
         }
     }
 
     T& getData(Entity entity) {
-        if(entity < entityConstants::MAX_ENTITIES) {
-            int index = _entityToIndexMap[entity];
-            if(index != -1) {
-                return _componentArray[index];
-            }
+        std::uint32_t index = getIndex(entity);
+        if(index != NO_INDEX) {
+            return _componentArray[index];
+        }
+
+        return _default;
+    }
+
+    T* tryGetData(Entity entity) {
+        std::uint32_t index = getIndex(entity);
+        if(index != NO_INDEX) {
+            return &_componentArray[index];
         }
 
-        return defaultValue();
+        return nullptr;
+    }
+
+    /**
+     * @brief Records that the entity's component changed at the given tick. Does nothing if the entity does not
+     * have the component. Safe to call for different entities from different threads.
+     */
+    void markChanged(Entity entity, std::uint32_t version) {
+        std::uint32_t index = getIndex(entity);
+        if(index != NO_INDEX) _versions[index] = version;
+    }
+
+    /**
+     * @return The change tick the entity's component was added or last marked changed at, or 0 if it has none
+     */
+    std::uint32_t getVersion(Entity entity) const {
+        std::uint32_t index = getIndex(entity);
+        return (index != NO_INDEX) ? _versions[index] : 0;
+    }
+
+    std::uint32_t getVersionAt(size_t index) const {
+        return _versions[index];
+    }
+
+    /**
+     * @brief Gets the component at the given position of the packed array. Index i belongs to the entity at
+     * index i of getAllOf().
+     */
+    T& getDataAt(size_t index) {
+        return _componentArray[index];
     }
 
-    const std::list<Entity> getAllOf() {
-        return _componentEntityPool;
+    /**
+     * @brief Gets every entity that owns this component, in packed array order. No copy is made, so the span is
+     * only valid until the next insertion or removal.
+     *
+     * @return View of the packed entity array
+     */
+    strb::span<const Entity> getAllOf() const {
+        return strb::span<const Entity>(_indexToEntityMap.data(), _indexToEntityMap.size());
+    }
+
+    /**
+     * @brief Gets the packed entity array itself. Unlike getAllOf() a reference to it stays valid while the
+     * array grows, which lets views keep iterating while entities are added.
+     */
+    const std::vector<Entity>& getPackedEntities() const {
+        return _indexToEntityMap;
+    }
+
+    size_t size() const {
+        return _indexToEntityMap.size();
     }
 
     bool hasComponent(Entity entity) {
-        if(entity < entityConstants::MAX_ENTITIES) return _entityToIndexMap[entity] != -1;
-        return false;
+        return getIndex(entity) != NO_INDEX;
     }
 
 private:
+    static constexpr std::uint32_t NO_INDEX = UINT32_MAX;
+
+    static constexpr size_t componentsPerPage() {
+        size_t count = 1;
+        while(count * 2 * sizeof(T) <= entityConstants::COMPONENT_PAGE_BYTES) count *= 2;
+        return count;
+    }
+
     /**
-     * @brief Method for creating default value for templated return. Probably not super safe.
-     * Taken from https://stackoverflow.com/a/48308107
-     * 
-     * @return Default T value
+     * @brief Looks up the entity's index in the packed arrays without allocating.
+     *
+     * @return The index, or NO_INDEX if the entity does not have this component or the handle is stale
      */
-    static T& defaultValue() {
-        static T* t = new T{};
-        return *t;
+    std::uint32_t getIndex(Entity entity) const {
+        std::uint32_t slot = entityHandle::getIndex(entity);
+        size_t page = slot / entityConstants::SPARSE_PAGE_SIZE;
+        if(page >= _entityToIndexMap.size()) return NO_INDEX;
+        std::uint32_t index = _entityToIndexMap[page][slot % entityConstants::SPARSE_PAGE_SIZE];
+        if(index == NO_INDEX || _indexToEntityMap[index] != entity) return NO_INDEX;
+        return index;
     }
 
     /**
-     * @brief -1 is considered an 'empty' index
+     * @brief Gets the lookup entry for the entity's slot, allocating its page if needed. Does not check the
+     * entity's generation.
      */
-    T _componentArray[entityConstants::MAX_ENTITIES];
+    std::uint32_t& getOrCreateIndex(Entity entity) {
+        std::uint32_t slot = entityHandle::getIndex(entity);
+        size_t page = slot / entityConstants::SPARSE_PAGE_SIZE;
+        if(page >= _entityToIndexMap.size()) _entityToIndexMap.resize(page + 1, emptyPage());
+        if(_entityToIndexMap[page] == emptyPage()) {
+            _entityToIndexMap[page] = new std::uint32_t[entityConstants::SPARSE_PAGE_SIZE];
+            for(size_t i = 0; i < entityConstants::SPARSE_PAGE_SIZE; ++i) {
+                _entityToIndexMap[page][i] = NO_INDEX;
+            }
+        }
+        return _entityToIndexMap[page][slot % entityConstants::SPARSE_PAGE_SIZE];
+    }
+
     /**
-     * @brief Maps entities to their place in the component array to keep it packed.
+     * @brief Shared, never written page of NO_INDEX entries. Unallocated lookup pages point here, so reading
+     * them needs no null check.
      */
-    int _entityToIndexMap[entityConstants::MAX_ENTITIES];
+    static std::uint32_t* emptyPage() {
+        static std::uint32_t* page = [] {
+            std::uint32_t* p = new std::uint32_t[entityConstants::SPARSE_PAGE_SIZE];
+            for(size_t i = 0; i < entityConstants::SPARSE_PAGE_SIZE; ++i) p[i] = NO_INDEX;
+            return p;
+        }();
+        return page;
+    }
+
     /**
-     * @brief Maps indexes of the component array to their respective entities
+     * @brief Returned by getData() for entities without the component. Kept per array rather than in a static so
+     * that separate worlds never write into each other's fallback.
      */
-    int _indexToEntityMap[entityConstants::MAX_ENTITIES];
+    T _default{};
     /**
-     * @brief The list of entities currently who have the component. This decreases entity lookup time at the expense of more memory. 
+     * @brief Packed components. Paged so that adding components never moves the existing ones.
      */
-    std::list<Entity> _componentEntityPool;
-
-    // Number of valid items in the component array currently
-    size_t _size = 0;
+    strb::paged_vector<T, componentsPerPage()> _componentArray;
+    /**
+     * @brief Maps entities to their place in the component array to keep it packed. Split into pages of
+     * SPARSE_PAGE_SIZE entities, allocated the first time an entity in that range gets the component.
+     */
+    std::vector<std::uint32_t*> _entityToIndexMap;
+    /**
+     * @brief Maps indexes of the component array to their respective entities, which doubles as the packed
+     * list of entities that own the component.
+     */
+    std::vector<Entity> _indexToEntityMap;
+    /**
+     * @brief Change version of each component, in the same order as the component array.
+     */
+    std::vector<std::uint32_t> _versions;
 };
 
 #endif
\ No newline at end of file
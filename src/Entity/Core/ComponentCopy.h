@@ -0,0 +1,17 @@
+#ifndef COMPONENT_COPY_H
+#define COMPONENT_COPY_H
+
+/**
+ * @brief How a component is copied when it is duplicated rather than moved: into and out of a WorldSnapshot, and
+ * from a Prototype into each new entity. By default that is the copy constructor. Components that point at state
+ * which every copy should have its own version of specialise this.
+ * Trivially copyable components are copied bytewise into snapshots instead.
+ */
+template<typename T>
+struct ComponentCopy {
+    static T copy(const T& component) {
+        return component;
+    }
+};
+
+#endif
\ No newline at end of file
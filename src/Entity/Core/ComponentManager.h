@@ -3,92 +3,231 @@
 
 #include "EntityConstants.h"
 #include "ComponentArray.h"
+#include "ComponentTypeRegistry.h"
+#include "EntityManager.h"
+#include "Tag.h"
 
 #include <cstdint>
 #include <memory>
-#include <unordered_map>
+#include <atomic>
+#include <bitset>
 #include <iostream>
+#include <mutex>
+#include <vector>
 
-using ComponentType = std::uint16_t;
-
+/**
+ * @brief Stores every component type in its own packed ComponentArray. Tags have no array; they are looked up in the
+ * entity signatures kept by the entity manager.
+ */
 class ComponentManager {
 public:
-    ComponentManager() = default;
+    /**
+     * @param entityManager The entity manager whose signatures tags are read from. May be nullptr for a manager
+     * that only holds a copy of the components, like the one in a WorldSnapshot.
+     */
+    explicit ComponentManager(const EntityManager* entityManager = nullptr) : _entityManager(entityManager) {}
     ~ComponentManager() = default;
 
     template<typename T>
     T& getComponent(Entity entity) {
-        return getComponentArray<T>()->getData(entity);
+        if constexpr(isTag<T>) {
+            return tagInstance<T>();
+        }
+        else {
+            return getComponentArray<T>()->getData(entity);
+        }
     }
 
+    /**
+     * @brief Gets the entity's component if it has one. Replaces a hasComponent() + getComponent() pair with a single lookup.
+     *
+     * @return Pointer to the component, or nullptr if the entity does not have it
+     */
     template<typename T>
-    ComponentType getComponentType() {
-        const char * typeName = typeid(T).name();
-        if(_componentTypes.find(typeName) != _componentTypes.end()) {
-            return _componentTypes[typeName];
+    T* tryGetComponent(Entity entity) {
+        if constexpr(isTag<T>) {
+            return hasComponent<T>(entity) ? &tagInstance<T>() : nullptr;
         }
         else {
-            registerComponent<T>();
-            return getComponentType<T>();
+            return getComponentArray<T>()->tryGetData(entity);
         }
     }
 
     template<typename T>
-    std::list<Entity> getAllOf() {
-        return getComponentArray<T>()->getAllOf();
+    ComponentType getComponentType() {
+        return ComponentTypeRegistry::getType<T>();
+    }
+
+    /**
+     * @brief Gets every entity that owns the component. Tags have no packed array to point into, so their entities
+     * are collected from the signatures on every call.
+     *
+     * @return View of the entities. For tags it is valid until the next call for the same tag.
+     */
+    template<typename T>
+    strb::span<const Entity> getAllOf() {
+        if constexpr(isTag<T>) {
+            std::vector<Entity>& entities = _tagged[getComponentType<T>()];
+            _entityManager->getEntitiesWith(getComponentType<T>(), entities);
+            return strb::span<const Entity>(entities.data(), entities.size());
+        }
+        else {
+            return getComponentArray<T>()->getAllOf();
+        }
     }
 
     template<typename T>
     bool hasComponent(Entity entity) {
-        return getComponentArray<T>()->hasComponent(entity);
+        if constexpr(isTag<T>) {
+            return _entityManager->hasComponentType(entity, getComponentType<T>());
+        }
+        else {
+            return getComponentArray<T>()->hasComponent(entity);
+        }
     }
 
+    /**
+     * @brief Stores the component. Does nothing for tags, which only live in the entity's signature.
+     */
     template<typename T>
     void addComponent(Entity entity, T component) {
-        getComponentArray<T>()->insertData(entity, component);
+        if constexpr(!isTag<T>) {
+            getComponentArray<T>()->insertData(entity, std::move(component), getChangeTick());
+        }
     }
 
-    template<typename T>
-    void removeComponent(Entity entity, T component) {
-        getComponentArray<T>()->removeData(entity, component);
+    /**
+     * @brief Adds several components to the entity in one call. Each type may only be listed once.
+     */
+    template<typename... Ts>
+    void addComponents(Entity entity, Ts... components) {
+        std::uint32_t tick = getChangeTick();
+        (insertComponent(entity, std::move(components), tick), ...);
     }
 
-    void entityDestroyed(Entity entity) {
-        for(auto keyValue : _componentArrays) {
-            keyValue.second->entityDestroyed(entity);
+    template<typename T>
+    void removeComponent(Entity entity) {
+        if constexpr(!isTag<T>) {
+            getComponentArray<T>()->removeData(entity);
         }
     }
 
-private:
     template<typename T>
-    void registerComponent() {
-        const char * typeName = typeid(T).name();
-        if(_componentTypes.find(typeName) == _componentTypes.end()) {
-            _componentTypes[typeName] = _nextAvailableComponentType;
-            _componentArrays.insert({typeName, std::make_shared<ComponentArray<T>>()});
-            ++_nextAvailableComponentType;
+    void markChanged(Entity entity) {
+        if constexpr(!isTag<T>) {
+            getComponentArray<T>()->markChanged(entity, getChangeTick());
         }
-        else {
-            std::cout << "Component already registered: " << typeName << std::endl;
+    }
+
+    std::uint32_t getChangeTick() const {
+        return _changeTick.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @return The change tick from before the call
+     */
+    std::uint32_t advanceChangeTick() {
+        return _changeTick.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Removes the entity from every component array it is in.
+     *
+     * @param entity The entity being destroyed
+     * @param signature The entity's signature, used to skip the arrays it has no component in
+     */
+    void entityDestroyed(Entity entity, std::bitset<entityConstants::MAX_COMPONENTS> signature) {
+        for(ComponentType type = 0; type < entityConstants::MAX_COMPONENTS && signature.any(); ++type) {
+            if(signature.test(type)) {
+                signature.reset(type);
+                if(_componentArrays[type] != nullptr) _componentArrays[type]->entityDestroyed(entity);
+            }
         }
     }
-    
+
+    /**
+     * @brief Replaces every component with a copy of other's. Copied components are recorded as changed at the
+     * current change tick, so views filtered on changes pick them all up.
+     */
+    void copyFrom(const ComponentManager& other) {
+        std::uint32_t tick = getChangeTick();
+        for(ComponentType type = 0; type < entityConstants::MAX_COMPONENTS; ++type) {
+            const IComponentArray* source = other._componentArrays[type].get();
+            if(source == nullptr) {
+                if(_componentArrays[type] != nullptr) _componentArrays[type]->clear();
+                continue;
+            }
+            if(_componentArrays[type] == nullptr) {
+                std::lock_guard<std::mutex> lock(_registerMutex);
+                _componentArrays[type] = source->createEmpty();
+                _arrayLookup[type].store(_componentArrays[type].get(), std::memory_order_release);
+            }
+            _componentArrays[type]->copyFrom(*source, tick);
+        }
+    }
+
+    /**
+     * @brief Adds the stats of every component type that has been used so far, in component type order.
+     */
+    void getStats(std::vector<ComponentStats>& stats) const {
+        for(auto& componentArray : _componentArrays) {
+            if(componentArray != nullptr) stats.push_back(componentArray->getStats());
+        }
+    }
+
+    const EntityManager* getEntityManager() const {
+        return _entityManager;
+    }
+
+    /**
+     * @brief Gets the array holding every component of the given type, creating it if this is the first use.
+     * Safe to call from scheduled systems running at the same time. Tags don't have one.
+     * 
+     * @return Pointer to the component array. Stays valid for the lifetime of the manager.
+     */
     template<typename T>
-    std::shared_ptr<ComponentArray<T>> getComponentArray() {
-        const char* typeName = typeid(T).name();
-        if(_componentTypes.find(typeName) != _componentTypes.end()) {
-            return std::static_pointer_cast<ComponentArray<T>>(_componentArrays[typeName]);
+    ComponentArray<T>* getComponentArray() {
+        static_assert(!isTag<T>, "Tags have no component array");
+        IComponentArray* componentArray = _arrayLookup[getComponentType<T>()].load(std::memory_order_acquire);
+        if(componentArray == nullptr) {
+            componentArray = registerComponent<T>();
         }
-        else {
-            registerComponent<T>();
-            return getComponentArray<T>();
+        return static_cast<ComponentArray<T>*>(componentArray);
+    }
+
+private:
+    template<typename T>
+    void insertComponent(Entity entity, T component, std::uint32_t tick) {
+        if constexpr(!isTag<T>) {
+            getComponentArray<T>()->insertData(entity, std::move(component), tick);
         }
     }
 
-    std::unordered_map<const char *, ComponentType> _componentTypes;
-    std::unordered_map<const char *, std::shared_ptr<IComponentArray>> _componentArrays;
+    template<typename T>
+    IComponentArray* registerComponent() {
+        ComponentType type = getComponentType<T>();
+        std::lock_guard<std::mutex> lock(_registerMutex);
+        if(_componentArrays[type] == nullptr) {
+            _componentArrays[type] = std::make_unique<ComponentArray<T>>();
+            _arrayLookup[type].store(_componentArrays[type].get(), std::memory_order_release);
+        }
+        return _componentArrays[type].get();
+    }
 
-    ComponentType _nextAvailableComponentType = 0;
+    /**
+     * @brief Component arrays indexed by component type. Arrays are created the first time their type is used.
+     */
+    std::unique_ptr<IComponentArray> _componentArrays[entityConstants::MAX_COMPONENTS];
+    /**
+     * @brief Same arrays as _componentArrays, published once they are created so lookups need no lock.
+     */
+    std::atomic<IComponentArray*> _arrayLookup[entityConstants::MAX_COMPONENTS] = {};
+    std::mutex _registerMutex;
+    const EntityManager* _entityManager = nullptr;
+    // Entities collected by getAllOf() for each tag
+    std::vector<Entity> _tagged[entityConstants::MAX_COMPONENTS];
+    // Starts above 0 so that every component counts as changed since tick 0
+    std::atomic<std::uint32_t> _changeTick = 1;
 
 };
 
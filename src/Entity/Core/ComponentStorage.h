@@ -0,0 +1,36 @@
+#ifndef COMPONENT_STORAGE_H
+#define COMPONENT_STORAGE_H
+
+/**
+ * @brief Picks how components are stored. By default every component type gets its own packed array
+ * (ComponentManager). Building with ECS_ARCHETYPE_STORAGE defined (the ECS_ARCHETYPE_STORAGE CMake option)
+ * groups entities with the same signature into chunks instead (ArchetypeComponentManager). Both expose the
+ * same interface to the EntityComponentSystem.
+ */
+#ifdef ECS_ARCHETYPE_STORAGE
+
+#include "ArchetypeView.h"
+
+using ComponentStorage = ArchetypeComponentManager;
+
+/**
+ * @brief View over every entity that owns all of Ts. Call exclude<...>() on it to filter out more components.
+ */
+template<typename... Ts>
+using View = BasicArchetypeView<ExcludeList<>, Ts...>;
+
+#else
+
+#include "View.h"
+
+using ComponentStorage = ComponentManager;
+
+/**
+ * @brief View over every entity that owns all of Ts. Call exclude<...>() on it to filter out more components.
+ */
+template<typename... Ts>
+using View = BasicView<ExcludeList<>, Ts...>;
+
+#endif
+
+#endif
\ No newline at end of file
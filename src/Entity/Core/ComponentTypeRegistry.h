@@ -0,0 +1,42 @@
+#ifndef COMPONENT_TYPE_REGISTRY_H
+#define COMPONENT_TYPE_REGISTRY_H
+
+#include "EntityConstants.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <atomic>
+#include <iostream>
+
+using ComponentType = std::uint16_t;
+
+/**
+ * @brief Assigns every component type a unique index the first time it is used. The index is cached in a
+ * function-local static per type, so looking it up afterwards is a single load instead of a typeid hash.
+ * Signatures and component tables have room for MAX_COMPONENTS types, so using one more aborts.
+ */
+class ComponentTypeRegistry {
+public:
+    template<typename T>
+    static ComponentType getType() {
+        static const ComponentType type = nextType();
+        return type;
+    }
+
+private:
+    ComponentTypeRegistry() = default;
+
+    static ComponentType nextType() {
+        ComponentType type = _nextAvailableComponentType++;
+        if(type >= entityConstants::MAX_COMPONENTS) {
+            std::cout << "Error: too many component types registered (" << (int) entityConstants::MAX_COMPONENTS << ")" << std::endl;
+            std::abort();
+        }
+        return type;
+    }
+
+    static inline std::atomic<ComponentType> _nextAvailableComponentType = 0;
+
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,100 @@
+#ifndef ECS_STATS_H
+#define ECS_STATS_H
+
+#include "ComponentTypeRegistry.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
+
+/**
+ * @brief Memory use and occupancy of one component type's storage.
+ */
+struct ComponentStats {
+    ComponentType type = 0;
+    std::string name;
+    // sizeof the component
+    size_t size = 0;
+    // Number of entities that have the component
+    size_t count = 0;
+    // Number of components that fit in the memory already allocated
+    size_t capacity = 0;
+    // Bytes allocated for the components and the bookkeeping that goes with them (lookups, versions)
+    size_t reservedBytes = 0;
+    // Bytes the live components own on the heap through their members, see HeapSize
+    size_t heapBytes = 0;
+};
+
+struct SystemStats {
+    std::string name;
+    size_t entities = 0;
+};
+
+/**
+ * @brief Snapshot of how much memory an EntityComponentSystem uses and how full it is, from
+ * EntityComponentSystem::getStats(). Gathering it walks every component, so it is meant for debugging rather
+ * than for every frame.
+ */
+struct EcsStats {
+    size_t entities = 0;
+    // Entity slots handed out so far, alive or waiting to be reused
+    size_t entitySlots = 0;
+    std::vector<ComponentStats> components;
+    std::vector<SystemStats> systems;
+
+    void writeJson(std::ostream& out) const {
+        out << "{\n";
+        out << "  \"entities\": " << entities << ",\n";
+        out << "  \"entitySlots\": " << entitySlots << ",\n";
+        out << "  \"components\": [";
+        for(size_t i = 0; i < components.size(); ++i) {
+            const ComponentStats& c = components[i];
+            out << ((i == 0) ? "\n" : ",\n");
+            out << "    {\"type\": " << c.type << ", \"name\": ";
+            writeString(out, c.name);
+            out << ", \"size\": " << c.size << ", \"count\": " << c.count << ", \"capacity\": " << c.capacity
+                << ", \"reservedBytes\": " << c.reservedBytes << ", \"heapBytes\": " << c.heapBytes << "}";
+        }
+        out << "\n  ],\n";
+        out << "  \"systems\": [";
+        for(size_t i = 0; i < systems.size(); ++i) {
+            out << ((i == 0) ? "\n" : ",\n");
+            out << "    {\"name\": ";
+            writeString(out, systems[i].name);
+            out << ", \"entities\": " << systems[i].entities << "}";
+        }
+        out << "\n  ]\n";
+        out << "}" << std::endl;
+    }
+
+    /**
+     * @brief Turns a typeid(T).name() into the type's name as written in code, where the compiler mangles it.
+     */
+    static std::string typeName(const char* name) {
+#ifdef __GNUG__
+        int status = 0;
+        std::unique_ptr<char, void (*)(void*)> demangled(abi::__cxa_demangle(name, nullptr, nullptr, &status), std::free);
+        if(status == 0) return demangled.get();
+#endif
+        return name;
+    }
+
+private:
+    static void writeString(std::ostream& out, const std::string& s) {
+        out << '"';
+        for(char c : s) {
+            if(c == '"' || c == '\\') out << '\\';
+            out << c;
+        }
+        out << '"';
+    }
+};
+
+#endif
\ No newline at end of file
@@ -2,8 +2,19 @@
 #define ENTITY_COMPONENT_SYSTEM_H
 
 #include "EntityManager.h"
-#include "ComponentManager.h"
+#include "ComponentStorage.h"
 #include "SystemManager.h"
+#include "CommandBuffer.h"
+#include "EventBus.h"
+#include "WorldSnapshot.h"
+#include "EcsStats.h"
+#include "Prototype.h"
+
+#include <algorithm>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include <iostream>
 
 /**
  * @brief Entity Component System used to create, destroy, and manage entities, as well as all components and systems.
@@ -11,8 +22,6 @@
  * to make this sleeker, but until we are at a point where that is necessary, this is how it will look.
  * 
  * Modified version of the following EntityComponentSystem - https://austinmorlan.com/posts/entity_component_system
- * 
- * TODO: Add observer methods
  */
 class EntityComponentSystem {
 public:
@@ -24,33 +33,90 @@ public:
      */
     void init() {
         _entityManager = std::make_unique<EntityManager>();
-        _componentManager = std::make_unique<ComponentManager>();
+        _componentManager = std::make_unique<ComponentStorage>(_entityManager.get());
         _systemManager = std::make_unique<SystemManager>();
+        _commandBuffer = std::make_unique<CommandBuffer>(_entityManager.get());
+        _eventBus = std::make_unique<EventBus>();
+        _dirtyEntities.clear();
     }
 
     // Entity
     /**
      * @brief Creates an entity that is immediately added to the entity component system
      * 
-     * @return The entity's unique identifier
+     * @return The entity's unique identifier, or entityConstants::NULL_ENTITY if no more entities can be created
      */
     Entity createEntity() {
         return _entityManager->createEntity();
     }
 
     /**
-     * @brief Removes the entity from the system
+     * @brief Creates an entity that already has all of the given components, e.g.
+     * createEntity(TransformComponent{pos, pos}, PhysicsComponent{}). The entity's signature is worked out once and
+     * every system is updated once, rather than once per addComponent() call. Each type may only be listed once.
+     * 
+     * @return The entity's unique identifier, or entityConstants::NULL_ENTITY if no more entities can be created
+     */
+    template<typename T, typename... Ts>
+    Entity createEntity(T component, Ts... components) {
+        Entity entity = _entityManager->createEntity();
+        if(entity == entityConstants::NULL_ENTITY) return entity;
+        _componentManager->addComponents(entity, std::move(component), std::move(components)...);
+
+        Signature signature;
+        signature.set(_componentManager->getComponentType<T>());
+        (signature.set(_componentManager->getComponentType<Ts>()), ...);
+        _entityManager->setSignature(entity, signature);
+
+        _systemManager->entitySignatureChanged(entity, signature);
+        return entity;
+    }
+
+    /**
+     * @brief Creates an entity with a copy of every component in the prototype, except for the given overrides,
+     * which are used in place of the prototype's components of the same type. Like createEntity(T, Ts...), the
+     * signature and systems are only updated once.
+     * 
+     * @return The entity's unique identifier, or entityConstants::NULL_ENTITY if no more entities can be created
+     */
+    template<typename... Ts, typename... Overrides>
+    Entity instantiate(const Prototype<Ts...>& prototype, Overrides... overrides) {
+        static_assert((prototypeDetail::isOneOf<Overrides, Ts...> && ...), "Overrides must be components of the prototype");
+        std::tuple<Overrides...> overrideComponents(std::move(overrides)...);
+        return createEntity(prototype.template make<Ts>(overrideComponents)...);
+    }
+
+    /**
+     * @brief Removes the entity from the system. Handles to it stop being alive, so they can't reach whichever
+     * entity reuses its slot.
      */
     void destroyEntity(Entity entity) {
-        for(auto system : _watchers[entity]) {
-            system->onEntityDelete(entity);
+        if(!_entityManager->isAlive(entity)) {
+            std::cout << "Error: tried to destroy entity that is not alive " << entity << std::endl;
+            return;
+        }
+        auto watchers = _watchers.find(entity);
+        if(watchers != _watchers.end()) {
+            for(auto system : watchers->second) {
+                system->onEntityDelete(entity);
+            }
+            _watchers.erase(watchers);
         }
-        _watchers[entity].clear();
+        _componentManager->entityDestroyed(entity, _entityManager->getSignature(entity));
         _entityManager->destroyEntity(entity);
-        _componentManager->entityDestroyed(entity);
         _systemManager->entityDestroyed(entity);
     }
 
+    /**
+     * @brief Checks whether the handle still refers to a live entity. Use this before touching an entity that was
+     * stored across frames, since it may have been destroyed in the meantime.
+     * 
+     * @return True if the entity has not been destroyed
+     */
+    bool isAlive(Entity entity) const {
+        return _entityManager->isAlive(entity);
+    }
+
     void addWatcher(System* system, Entity entity) {
         _watchers[entity].push_back(system);
     }
@@ -61,27 +127,79 @@ public:
      */
     template<typename T>
     void addComponent(Entity entity, T component) {
-        _componentManager->addComponent(entity, component);
-        
-        Signature signature = _entityManager->getSignature(entity);
-        signature.set(_componentManager->getComponentType<T>(), true);
-        _entityManager->setSignature(entity, signature);
+        if(!_entityManager->isAlive(entity)) {
+            std::cout << "Error: tried to add component to entity that is not alive " << entity << std::endl;
+            return;
+        }
+        applyAddComponent(entity, std::move(component));
+        _systemManager->entitySignatureChanged(entity, _entityManager->getSignature(entity));
+    }
 
-        _systemManager->entitySignatureChanged(entity, signature);
+    /**
+     * @brief Removes a component from the entity. Does nothing if the entity does not have it.
+     */
+    template<typename T>
+    void removeComponent(Entity entity) {
+        if(!_entityManager->isAlive(entity)) {
+            std::cout << "Error: tried to remove component from entity that is not alive " << entity << std::endl;
+            return;
+        }
+        applyRemoveComponent<T>(entity);
+        _systemManager->entitySignatureChanged(entity, _entityManager->getSignature(entity));
     }
 
     /**
      * @brief Gets the component owned by the entity
      * 
-     * @return The reference to the entity's component, or a blank component if the entity does not have it.
+     * @return The reference to the entity's component, or a blank component if the entity does not have it or is not alive.
      */
     template<typename T>
     T& getComponent(Entity entity) {
         return _componentManager->getComponent<T>(entity);
     }
+
+    /**
+     * @brief Gets the component owned by the entity if there is one. Use this instead of hasComponent() followed
+     * by getComponent() so the component is only looked up once.
+     * 
+     * @return Pointer to the entity's component, or nullptr if the entity does not have it or is not alive.
+     */
+    template<typename T>
+    T* tryGetComponent(Entity entity) {
+        return _componentManager->tryGetComponent<T>(entity);
+    }
     
     /**
-     * @brief Gets the component type in a human readable string. Used for hash table mapping usually.
+     * @brief Records that the entity's component was modified, so views filtered with changed<T>() visit it. Code
+     * that writes to a component other systems derive data from (like TransformComponent) must call this. Safe to
+     * call for different entities from different threads.
+     */
+    template<typename T>
+    void markChanged(Entity entity) {
+        _componentManager->markChanged<T>(entity);
+    }
+
+    /**
+     * @brief Gets the current change tick. Added components, and components marked changed, record this tick.
+     */
+    std::uint32_t getChangeTick() const {
+        return _componentManager->getChangeTick();
+    }
+
+    /**
+     * @brief Moves on to the next change tick, so every change from now on is newer than the returned tick.
+     * Systems that keep derived data up to date call this at the start of each update, and pass the result to
+     * view<...>().changed<...>() the next time, so changes made while they run are picked up next time too.
+     * 
+     * @return The change tick from before the call
+     */
+    std::uint32_t advanceChangeTick() {
+        return _componentManager->advanceChangeTick();
+    }
+
+    /**
+     * @brief Gets the component type's index. Each type is assigned its index once, the first time it is used,
+     * and the index is also the type's bit in an entity's signature.
      * 
      * @return The component type
      */
@@ -91,7 +209,8 @@ public:
     }
 
     /**
-     * @brief Determines whether or not the entity has a given component
+     * @brief Determines whether or not the entity has a given component. For tags this is a single bit test on the
+     * entity's signature.
      * 
      * @return True if entity has component, false if not
      */
@@ -101,24 +220,137 @@ public:
     }
 
     /**
-     * @brief Gets all entities that own the specified component
+     * @brief Gets all entities that own the specified component. This is a view straight into the component's
+     * packed array, so it costs nothing to call every frame but is invalidated by adding or removing that component.
+     * If entities are destroyed while looping, iterate from back to front so that no entity is skipped.
+     * With archetype storage, and for tags, the entities are instead copied into a list on every call, so prefer
+     * view<T>() there.
      * 
-     * @return The list of all entities with the specified component
+     * @return The span of all entities with the specified component
      */
     template<typename T>
-    std::list<Entity> getAllOf() {
+    strb::span<const Entity> getAllOf() {
         return _componentManager->getAllOf<T>();
-    } 
+    }
+
+    /**
+     * @brief Gets a view over every entity that owns all of the given components. Filter it further with
+     * exclude<...>(), e.g. view<PhysicsComponent, TransformComponent>().exclude<PlayerComponent>().
+     * Only the current entity may be destroyed while iterating.
+     * 
+     * @return The view, which can be used in a range-for as (entity, components...)
+     */
+    template<typename... Ts>
+    View<Ts...> view() {
+        return View<Ts...>(_componentManager.get());
+    }
+
+    // Commands
+    /**
+     * @brief Gets the buffer for structural changes that have to wait until nothing is being iterated, e.g.
+     * destroying entities from inside a view or a system's entity loop.
+     */
+    CommandBuffer& getCommandBuffer() {
+        return *_commandBuffer;
+    }
+
+    /**
+     * @brief Applies every command recorded in the command buffer, in order. System entity lists are only
+     * updated once per changed entity, after all of the commands have run. Commands for entities that were
+     * already destroyed are skipped. Must not be called while iterating.
+     */
+    void flushCommands() {
+        for(auto& command : _commandBuffer->take()) {
+            if(!_entityManager->isAlive(command.entity)) continue;
+            if(command.apply) {
+                command.apply(*this);
+                _dirtyEntities.push_back(command.entity);
+            }
+            else {
+                destroyEntity(command.entity);
+            }
+        }
+
+        std::sort(_dirtyEntities.begin(), _dirtyEntities.end());
+        _dirtyEntities.erase(std::unique(_dirtyEntities.begin(), _dirtyEntities.end()), _dirtyEntities.end());
+        for(auto entity : _dirtyEntities) {
+            if(_entityManager->isAlive(entity)) {
+                _systemManager->entitySignatureChanged(entity, _entityManager->getSignature(entity));
+            }
+        }
+        _dirtyEntities.clear();
+    }
+
+    // Events
+    /**
+     * @brief Gets the bus systems publish events on, e.g. a pickup being collected, for the game to drain and
+     * react to once the systems that publish them have run.
+     */
+    EventBus& getEventBus() {
+        return *_eventBus;
+    }
+
+    // Snapshots
+    /**
+     * @brief Copies the whole world into the snapshot: entities, components, system entity lists and watchers.
+     * Capturing into the same snapshot again reuses its memory. Commands waiting in the command buffer and
+     * events waiting on the event bus are not part of the snapshot. Must not be called while iterating.
+     */
+    void captureSnapshot(WorldSnapshot& snapshot) {
+        if(snapshot._componentManager == nullptr) snapshot._componentManager = std::make_unique<ComponentStorage>();
+        snapshot._entityManager = *_entityManager;
+        snapshot._componentManager->copyFrom(*_componentManager);
+        _systemManager->captureEntities(snapshot._systemEntities);
+        snapshot._watchers = _watchers;
+    }
+
+    /**
+     * @brief Puts the world back the way it was when the snapshot was captured. Entity handles are restored too, so
+     * handles taken before the capture are valid again and handles to entities created since are not. Every
+     * restored component counts as changed, and commands waiting in the command buffer and events waiting on the
+     * event bus are dropped. The snapshot must come from this EntityComponentSystem, and this must not be called
+     * while iterating.
+     */
+    void restoreSnapshot(const WorldSnapshot& snapshot) {
+        if(snapshot.empty()) return;
+        _commandBuffer->take();
+        _eventBus->clear();
+        *_entityManager = snapshot._entityManager;
+        _componentManager->copyFrom(*snapshot._componentManager);
+        _systemManager->restoreEntities(snapshot._systemEntities);
+        _watchers = snapshot._watchers;
+    }
+
+    // Stats
+    /**
+     * @brief Gathers how much memory every component type uses and how full its storage is, plus how many
+     * entities every system has. Walks every component, so use it for debugging rather than every frame. Write
+     * the result out with EcsStats::writeJson().
+     */
+    EcsStats getStats() {
+        EcsStats stats;
+        stats.entities = _entityManager->getLivingEntityCount();
+        stats.entitySlots = _entityManager->getSlotCount();
+        _componentManager->getStats(stats.components);
+        _systemManager->getStats(stats.systems);
+        std::sort(stats.systems.begin(), stats.systems.end(), [](const SystemStats& a, const SystemStats& b) {
+            return a.name < b.name;
+        });
+        return stats;
+    }
 
     // System
     /**
      * @brief Registers a system in the entity component system so that it can interact with entities properly.
+     * The system reaches this entity component system through its _ecs member.
      * 
      * @return A shared pointer to the system created in the entity component system.
      */
     template<typename T>
     std::shared_ptr<T> registerSystem() {
-        return _systemManager->registerSystem<T>();
+        std::shared_ptr<T> system = _systemManager->registerSystem<T>();
+        if(system != nullptr) system->_ecs = this;
+        return system;
     }
 
     /**
@@ -130,10 +362,41 @@ public:
     }
 
 private:
+    friend class CommandBuffer;
+
+    /**
+     * @brief Adds the component and updates the entity's signature, but leaves system entity lists alone.
+     */
+    template<typename T>
+    void applyAddComponent(Entity entity, T component) {
+        _componentManager->addComponent(entity, std::move(component));
+
+        Signature signature = _entityManager->getSignature(entity);
+        signature.set(_componentManager->getComponentType<T>(), true);
+        _entityManager->setSignature(entity, signature);
+    }
+
+    /**
+     * @brief Removes the component and updates the entity's signature, but leaves system entity lists alone.
+     */
+    template<typename T>
+    void applyRemoveComponent(Entity entity) {
+        _componentManager->removeComponent<T>(entity);
+
+        Signature signature = _entityManager->getSignature(entity);
+        signature.set(_componentManager->getComponentType<T>(), false);
+        _entityManager->setSignature(entity, signature);
+    }
+
     std::unique_ptr<EntityManager> _entityManager = nullptr;
-    std::unique_ptr<ComponentManager> _componentManager = nullptr;
+    std::unique_ptr<ComponentStorage> _componentManager = nullptr;
     std::unique_ptr<SystemManager> _systemManager = nullptr;
-    std::vector<System*> _watchers[entityConstants::MAX_ENTITIES];
+    // Only a handful of entities are ever watched, so this is keyed rather than sized for every possible entity
+    std::unordered_map<Entity, std::vector<System*>> _watchers;
+    std::unique_ptr<CommandBuffer> _commandBuffer = nullptr;
+    std::unique_ptr<EventBus> _eventBus = nullptr;
+    // Entities whose signature changed during the current flush
+    std::vector<Entity> _dirtyEntities;
 
 };
 
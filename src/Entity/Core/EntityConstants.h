@@ -2,10 +2,24 @@
 #define ENTITY_CONSTANTS_H
 
 #include <cstdint>
+#include <cstddef>
 
 namespace entityConstants {
     const std::uint8_t MAX_COMPONENTS = 64;
-    const std::uint16_t MAX_ENTITIES = 512;
+    // An entity handle keeps its slot index in the low bits and the slot's generation in the rest
+    const std::uint32_t ENTITY_INDEX_BITS = 20;
+    const std::uint32_t ENTITY_INDEX_MASK = (1u << ENTITY_INDEX_BITS) - 1;
+    const std::uint32_t ENTITY_GENERATION_MASK = UINT32_MAX >> ENTITY_INDEX_BITS;
+    // Returned by createEntity() when no more entities can be created. Never a valid entity.
+    const std::uint32_t NULL_ENTITY = UINT32_MAX;
+    // Number of entity slots. The last index is never handed out so that NULL_ENTITY can't be a live handle.
+    const std::uint32_t MAX_ENTITIES = ENTITY_INDEX_MASK;
+    // Entities per page of a component array's entity -> index lookup
+    const std::size_t SPARSE_PAGE_SIZE = 4096;
+    // Target bytes per page of packed component storage
+    const std::size_t COMPONENT_PAGE_BYTES = 16 * 1024;
+    // Entities per batch when a system splits a view across threads
+    const std::size_t PARALLEL_BATCH_SIZE = 256;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,30 @@
+#ifndef ENTITY_HANDLE_H
+#define ENTITY_HANDLE_H
+
+#include "EntityConstants.h"
+
+#include <cstdint>
+
+using Entity = std::uint32_t;
+
+/**
+ * @brief Helpers for taking apart an Entity handle. The low ENTITY_INDEX_BITS bits are the slot the entity lives in,
+ * and the rest count how many times that slot has been reused. Once an entity is destroyed its slot's generation
+ * moves on, so any handle to it that is still lying around no longer matches and can be rejected in O(1).
+ * Generations wrap after 4096 reuses of the same slot.
+ */
+namespace entityHandle {
+    inline std::uint32_t getIndex(Entity entity) {
+        return entity & entityConstants::ENTITY_INDEX_MASK;
+    }
+
+    inline std::uint32_t getGeneration(Entity entity) {
+        return entity >> entityConstants::ENTITY_INDEX_BITS;
+    }
+
+    inline Entity create(std::uint32_t index, std::uint32_t generation) {
+        return ((generation & entityConstants::ENTITY_GENERATION_MASK) << entityConstants::ENTITY_INDEX_BITS) | index;
+    }
+};
+
+#endif
\ No newline at end of file
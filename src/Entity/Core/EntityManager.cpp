@@ -2,29 +2,33 @@
 
 #include <iostream>
 
-EntityManager::EntityManager() {
-    for(Entity id = 0; id < entityConstants::MAX_ENTITIES; ++id) {
-        _availableIds.push(id);
-    }
-}
-
 Entity EntityManager::createEntity() {
-    if(_activeEntities < entityConstants::MAX_ENTITIES) {
-        Entity id = _availableIds.front();
+    std::uint32_t index;
+    if(!_availableIds.empty()) {
+        index = _availableIds.front();
         _availableIds.pop();
-        ++_activeEntities;
-        
-        return id;
+    }
+    else if(_slots.size() < entityConstants::MAX_ENTITIES) {
+        index = _slots.size();
+        _slots.emplace_back();
+    }
+    else {
+        std::cout << "Error: currently at max entities (" << entityConstants::MAX_ENTITIES << ")" << std::endl;
+        return entityConstants::NULL_ENTITY;
     }
 
-    std::cout << "Error: currently at max entities (" << entityConstants::MAX_ENTITIES << ")" << std::endl;
-    return -1;
+    _slots[index].alive = true;
+    ++_activeEntities;
+    return entityHandle::create(index, _slots[index].generation);
 }
 
 void EntityManager::destroyEntity(Entity entity) {
-    if(entity < entityConstants::MAX_ENTITIES) {
-        _signatures[entity].reset();
-        _availableIds.push(entity);
+    if(isAlive(entity)) {
+        std::uint32_t index = entityHandle::getIndex(entity);
+        _slots[index].signature.reset();
+        _slots[index].alive = false;
+        ++_slots[index].generation;
+        _availableIds.push(index);
         --_activeEntities;
     }
     else {
@@ -32,9 +36,15 @@ void EntityManager::destroyEntity(Entity entity) {
     }
 }
 
+bool EntityManager::isAlive(Entity entity) const {
+    std::uint32_t index = entityHandle::getIndex(entity);
+    return index < _slots.size() && _slots[index].alive &&
+        (_slots[index].generation & entityConstants::ENTITY_GENERATION_MASK) == entityHandle::getGeneration(entity);
+}
+
 void EntityManager::setSignature(Entity entity, Signature signature) {
-    if(entity < entityConstants::MAX_ENTITIES) {
-        _signatures[entity] = signature;
+    if(isAlive(entity)) {
+        _slots[entityHandle::getIndex(entity)].signature = signature;
     }
     else {
         std::cout << "Error: invalid entity ID for setting signature entity " << entity << std::endl;
@@ -42,11 +52,20 @@ void EntityManager::setSignature(Entity entity, Signature signature) {
 }
 
 Signature EntityManager::getSignature(Entity entity) {
-    if(entity < entityConstants::MAX_ENTITIES) {
-        return _signatures[entity];
+    if(isAlive(entity)) {
+        return _slots[entityHandle::getIndex(entity)].signature;
     }
     else {
         std::cout << "Error: invalid entity ID for getting signature entity " << entity << std::endl;
     }
     return Signature();
+}
+
+void EntityManager::getEntitiesWith(std::size_t type, std::vector<Entity>& entities) const {
+    entities.clear();
+    for(std::uint32_t index = 0; index < _slots.size(); ++index) {
+        if(_slots[index].alive && _slots[index].signature.test(type)) {
+            entities.push_back(entityHandle::create(index, _slots[index].generation));
+        }
+    }
 }
\ No newline at end of file
@@ -2,33 +2,43 @@
 #define ENTITY_MANAGER_H
 
 #include "EntityConstants.h"
+#include "EntityHandle.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <queue>
+#include <vector>
 #include <bitset>
 
-using Entity = std::uint16_t;
 using Signature = std::bitset<entityConstants::MAX_COMPONENTS>;
 
 class EntityManager {
 public:
-    EntityManager();
+    EntityManager() = default;
     ~EntityManager() = default;
 
     /**
      * @brief Creates an entity to be added to the entity manager
      * 
-     * @return The entity ID of the newly created entity
+     * @return The entity ID of the newly created entity, or entityConstants::NULL_ENTITY if no more can be created
      */
     Entity createEntity();
 
     /**
-     * @brief Destroys an entity, freeing up that ID
+     * @brief Destroys an entity, freeing up its slot. The slot's generation is bumped so that existing
+     * handles to the entity stop being alive.
      * 
      * @param entity The entity ID to be destroyed
      */
     void destroyEntity(Entity entity);
 
+    /**
+     * @brief Checks that the handle refers to an entity that has not been destroyed
+     * 
+     * @return True if the entity is alive, false if it was destroyed or never existed
+     */
+    bool isAlive(Entity entity) const;
+
     /**
      * @brief Set the entity's component signature
      * 
@@ -45,10 +55,62 @@ public:
      */
     Signature getSignature(Entity entity);
 
+    /**
+     * @brief Checks a single bit of the entity's signature. Inline, since this is how tags are looked up.
+     * 
+     * @return True if the entity is alive and its signature has the component type
+     */
+    bool hasComponentType(Entity entity, std::size_t type) const {
+        std::uint32_t index = entityHandle::getIndex(entity);
+        // Destroyed entities have their signature cleared, so only the generation needs checking
+        return index < _slots.size() && _slots[index].signature[type] &&
+            (_slots[index].generation & entityConstants::ENTITY_GENERATION_MASK) == entityHandle::getGeneration(entity);
+    }
+
+    /**
+     * @brief Gets the signature of an entity that is known to be alive, e.g. one taken from a component array,
+     * without checking the handle.
+     */
+    const Signature& getLiveSignature(Entity entity) const {
+        return _slots[entityHandle::getIndex(entity)].signature;
+    }
+
+    /**
+     * @brief Replaces the contents of entities with every living entity whose signature has the component type,
+     * in slot order.
+     */
+    void getEntitiesWith(std::size_t type, std::vector<Entity>& entities) const;
+
+    /**
+     * @brief Gets the number of entities that are alive
+     */
+    std::uint32_t getLivingEntityCount() const {
+        return _activeEntities;
+    }
+
+    /**
+     * @brief Gets the number of slots handed out so far, including ones waiting to be reused
+     */
+    size_t getSlotCount() const {
+        return _slots.size();
+    }
+
 private:
-    std::queue<Entity> _availableIds;
-    Signature _signatures[entityConstants::MAX_ENTITIES];
-    int _activeEntities = 0;
+    struct EntitySlot {
+        Signature signature;
+        std::uint32_t generation = 0;
+        bool alive = false;
+    };
+
+    /**
+     * @brief Slot indexes of destroyed entities, reused oldest first before any new slot is handed out.
+     */
+    std::queue<std::uint32_t> _availableIds;
+    /**
+     * @brief Slots indexed by entity index. Grows as new slots are handed out.
+     */
+    std::vector<EntitySlot> _slots;
+    std::uint32_t _activeEntities = 0;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,114 @@
+#ifndef ENTITY_SET_H
+#define ENTITY_SET_H
+
+#include "EntityConstants.h"
+#include "EntityHandle.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Set of entities stored as a packed array plus a sparse slot -> index lookup, the same layout as a
+ * ComponentArray without the components. Insert, erase and contains are O(1), and iterating is a walk over
+ * contiguous memory.
+ *
+ * Members are kept in entity slot order, the order prefabs fill component storage in, so walking the set walks
+ * the component arrays front to back. Insert and erase stay O(1) by only noting when they break that order, and
+ * sort() puts it back before a loop. Loops that can erase the current entity, or insert new ones, should sort
+ * first and then walk the set back to front by index.
+ */
+class EntitySet {
+public:
+    /**
+     * @brief Adds the entity. Does nothing if it is already in the set. An entity in the same slot with an older
+     * handle is replaced.
+     */
+    void insert(Entity entity) {
+        std::uint32_t slot = entityHandle::getIndex(entity);
+        if(slot >= _sparse.size()) _sparse.resize(slot + 1, NO_INDEX);
+        std::uint32_t index = _sparse[slot];
+        if(index != NO_INDEX) {
+            _dense[index] = entity;
+            return;
+        }
+        if(!_dense.empty() && slot < entityHandle::getIndex(_dense.back())) _sorted = false;
+        _sparse[slot] = _dense.size();
+        _dense.push_back(entity);
+    }
+
+    /**
+     * @brief Removes the entity by moving the last entity into its place. Does nothing if it is not in the set.
+     */
+    void erase(Entity entity) {
+        std::uint32_t index = getIndex(entity);
+        if(index == NO_INDEX) return;
+        Entity last = _dense.back();
+        if(index != _dense.size() - 1) _sorted = false;
+        _dense[index] = last;
+        _sparse[entityHandle::getIndex(last)] = index;
+        _sparse[entityHandle::getIndex(entity)] = NO_INDEX;
+        _dense.pop_back();
+    }
+
+    /**
+     * @brief Puts the members back in slot order. Does nothing if no insert or erase has moved them out of it.
+     */
+    void sort() {
+        if(_sorted) return;
+        std::sort(_dense.begin(), _dense.end(), [](Entity a, Entity b) {
+            return entityHandle::getIndex(a) < entityHandle::getIndex(b);
+        });
+        for(size_t i = 0; i < _dense.size(); ++i) {
+            _sparse[entityHandle::getIndex(_dense[i])] = i;
+        }
+        _sorted = true;
+    }
+
+    bool contains(Entity entity) const {
+        return getIndex(entity) != NO_INDEX;
+    }
+
+    size_t size() const {
+        return _dense.size();
+    }
+
+    bool empty() const {
+        return _dense.empty();
+    }
+
+    Entity operator[](size_t index) const {
+        return _dense[index];
+    }
+
+    std::vector<Entity>::const_iterator begin() const {
+        return _dense.begin();
+    }
+
+    std::vector<Entity>::const_iterator end() const {
+        return _dense.end();
+    }
+
+private:
+    static constexpr std::uint32_t NO_INDEX = UINT32_MAX;
+
+    /**
+     * @return The entity's index in the packed array, or NO_INDEX if it is not in the set or the handle is stale
+     */
+    std::uint32_t getIndex(Entity entity) const {
+        std::uint32_t slot = entityHandle::getIndex(entity);
+        if(slot >= _sparse.size()) return NO_INDEX;
+        std::uint32_t index = _sparse[slot];
+        if(index == NO_INDEX || _dense[index] != entity) return NO_INDEX;
+        return index;
+    }
+
+    std::vector<Entity> _dense;
+    // Indexed by entity slot. Grows to the highest slot inserted so far.
+    std::vector<std::uint32_t> _sparse;
+    // False once an insert or erase has left _dense out of slot order
+    bool _sorted = true;
+
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,185 @@
+#ifndef EVENT_BUS_H
+#define EVENT_BUS_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+using EventType = std::uint16_t;
+
+/**
+ * @brief Type-erased event queue, so the bus can clear every queue without knowing the event types.
+ */
+class IEventQueue {
+public:
+    IEventQueue() = default;
+    virtual ~IEventQueue() = default;
+
+    virtual void clear() = 0;
+
+};
+
+/**
+ * @brief Ring buffer of events of one type. It only grows when more events are waiting than ever before, so once
+ * the game has warmed up publishing and draining don't allocate. Event slots are reused rather than destroyed, so
+ * events should be default constructible and cheap to assign.
+ */
+template<typename E>
+class EventQueue : public IEventQueue {
+public:
+    EventQueue() = default;
+    ~EventQueue() = default;
+
+    /**
+     * @brief Adds the event to the back of the queue. Safe to call from several threads at once.
+     */
+    void publish(E event) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(_size == _events.size()) grow();
+        _events[(_head + _size) & (_events.size() - 1)] = std::move(event);
+        ++_size;
+    }
+
+    /**
+     * @brief Calls handler(event) for every event waiting, oldest first, and removes them. Events published by
+     * the handler wait for the next drain. Must not be called at the same time as publish().
+     * 
+     * @return The number of events handled
+     */
+    template<typename F>
+    size_t drain(F&& handler) {
+        size_t count = _size;
+        for(size_t i = 0; i < count; ++i) {
+            // Moved out first, since a handler that publishes can reuse or reallocate the slot
+            E event = std::move(_events[_head]);
+            _head = (_head + 1) & (_events.size() - 1);
+            --_size;
+            handler(event);
+        }
+        return count;
+    }
+
+    void clear() override {
+        _head = 0;
+        _size = 0;
+    }
+
+    size_t size() const {
+        return _size;
+    }
+
+private:
+    /**
+     * @brief Doubles the buffer, moving the waiting events to the front of it.
+     */
+    void grow() {
+        std::vector<E> events(_events.empty() ? 16 : _events.size() * 2);
+        for(size_t i = 0; i < _size; ++i) {
+            events[i] = std::move(_events[(_head + i) & (_events.size() - 1)]);
+        }
+        _events.swap(events);
+        _head = 0;
+    }
+
+    // Size is always a power of two, so positions wrap with a mask
+    std::vector<E> _events;
+    size_t _head = 0;
+    size_t _size = 0;
+    std::mutex _mutex;
+
+};
+
+/**
+ * @brief Typed events passed from the systems that notice something happen to the code that reacts to it, e.g.
+ * collision checks publishing a PickupEvent for every pickup the player touched. Each event type gets its own
+ * EventQueue the first time it is used. Producers publish while systems run, and consumers drain whole queues at
+ * fixed points of the frame.
+ */
+class EventBus {
+public:
+    EventBus() = default;
+    ~EventBus() = default;
+
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    /**
+     * @brief Queues the event. Safe to call from several threads at once.
+     */
+    template<typename E>
+    void publish(E event) {
+        getQueue<E>()->publish(std::move(event));
+    }
+
+    /**
+     * @brief Calls handler(event) for every queued event of type E, oldest first, and removes them. Must not be
+     * called while anything may be publishing events of the same type.
+     * 
+     * @return The number of events handled
+     */
+    template<typename E, typename F>
+    size_t drain(F&& handler) {
+        return getQueue<E>()->drain(std::forward<F>(handler));
+    }
+
+    /**
+     * @brief Drops every queued event of every type.
+     */
+    void clear() {
+        std::lock_guard<std::mutex> lock(_registerMutex);
+        for(auto& queue : _queues) {
+            if(queue != nullptr) queue->clear();
+        }
+    }
+
+private:
+    static constexpr size_t MAX_EVENT_TYPES = 32;
+
+    template<typename E>
+    static EventType getType() {
+        static const EventType type = nextType();
+        return type;
+    }
+
+    static EventType nextType() {
+        EventType type = _nextEventType++;
+        if(type >= MAX_EVENT_TYPES) {
+            std::cout << "Error: too many event types registered (" << MAX_EVENT_TYPES << ")" << std::endl;
+            std::abort();
+        }
+        return type;
+    }
+
+    /**
+     * @brief Gets the queue for the event type, creating it the first time. Safe to call from several threads.
+     */
+    template<typename E>
+    EventQueue<E>* getQueue() {
+        EventType type = getType<E>();
+        IEventQueue* queue = _queueLookup[type].load(std::memory_order_acquire);
+        if(queue == nullptr) {
+            std::lock_guard<std::mutex> lock(_registerMutex);
+            if(_queues[type] == nullptr) {
+                _queues[type] = std::make_unique<EventQueue<E>>();
+                _queueLookup[type].store(_queues[type].get(), std::memory_order_release);
+            }
+            queue = _queues[type].get();
+        }
+        return static_cast<EventQueue<E>*>(queue);
+    }
+
+    static inline std::atomic<EventType> _nextEventType = 0;
+
+    std::unique_ptr<IEventQueue> _queues[MAX_EVENT_TYPES];
+    // Lock-free copy of _queues for lookups once a queue exists
+    std::atomic<IEventQueue*> _queueLookup[MAX_EVENT_TYPES] = {};
+    std::mutex _registerMutex;
+
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,46 @@
+#ifndef HEAP_SIZE_H
+#define HEAP_SIZE_H
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief How many heap bytes a component owns through its members, for EcsStats. Zero unless the component
+ * specialises this. Memory shared between components (like scripts) should not be counted.
+ */
+template<typename T>
+struct HeapSize {
+    static size_t of(const T&) {
+        return 0;
+    }
+};
+
+/**
+ * @brief Heap bytes owned by common member types, for use in HeapSize specialisations. Container sizes are
+ * estimates based on their capacity, since allocator overhead isn't visible.
+ */
+namespace heapSize {
+    inline size_t of(const std::string& s) {
+        // Short strings live inside the string object itself
+        static const size_t inlineCapacity = std::string().capacity();
+        return (s.capacity() > inlineCapacity) ? s.capacity() + 1 : 0;
+    }
+
+    template<typename T>
+    size_t of(const std::vector<T>& v) {
+        return v.capacity() * sizeof(T);
+    }
+
+    /**
+     * @brief Bucket array plus one node per element. Heap memory owned by the keys and values is not included.
+     */
+    template<typename K, typename V>
+    size_t of(const std::unordered_map<K, V>& m) {
+        return m.bucket_count() * sizeof(void*) + m.size() * (sizeof(std::pair<const K, V>) + 2 * sizeof(void*));
+    }
+};
+
+#endif
\ No newline at end of file
@@ -1,9 +1,12 @@
 #ifndef ICOMPONENT_ARRAY_H
 #define ICOMPONENT_ARRAY_H
 
+#include "EcsStats.h"
+
 #include <cstdint>
+#include <memory>
 
-using Entity = std::uint16_t;
+using Entity = std::uint32_t;
 
 /**
  * @brief Interface class for the component array. Required so that when an entity is destroyed, we
@@ -16,6 +19,28 @@ public:
 
     virtual void entityDestroyed(Entity entity) = 0;
 
+    /**
+     * @brief Creates an empty array for the same component type.
+     */
+    virtual std::unique_ptr<IComponentArray> createEmpty() const = 0;
+
+    /**
+     * @brief Replaces every component with a copy of other's. Other must be an array of the same component type.
+     *
+     * @param version The change tick to record every copied component as changed at
+     */
+    virtual void copyFrom(const IComponentArray& other, std::uint32_t version) = 0;
+
+    /**
+     * @brief Removes every component, keeping the memory for reuse.
+     */
+    virtual void clear() = 0;
+
+    /**
+     * @brief Gets the array's memory use and occupancy. Walks every component to add up their heap memory.
+     */
+    virtual ComponentStats getStats() const = 0;
+
 private:
 
 };
@@ -0,0 +1,63 @@
+#ifndef PROTOTYPE_H
+#define PROTOTYPE_H
+
+#include "ComponentCopy.h"
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace prototypeDetail {
+    template<typename T, typename... Ts>
+    constexpr bool isOneOf = (std::is_same_v<T, Ts> || ...);
+};
+
+/**
+ * @brief A set of components to create entities from. Build it once, then create each entity with
+ * EntityComponentSystem::instantiate(), which copies the components into a new entity with a single signature
+ * update. Components that differ per entity are passed to instantiate() and used instead of the prototype's, e.g.
+ * ecs->instantiate(prototype, TransformComponent{pos, pos}).
+ *
+ * Components are copied with ComponentCopy, so scripts with state of their own are cloned for every entity and
+ * stateless ones are shared.
+ *
+ * A prototype holds no entities, so one prototype can be instantiated into any number of worlds.
+ *
+ * @tparam Ts The components every entity made from the prototype has. Each type may only be listed once.
+ */
+template<typename... Ts>
+class Prototype {
+public:
+    explicit Prototype(Ts... components) : _components(std::move(components)...) {}
+    ~Prototype() = default;
+
+    template<typename T>
+    T& get() {
+        return std::get<T>(_components);
+    }
+
+    template<typename T>
+    const T& get() const {
+        return std::get<T>(_components);
+    }
+
+    /**
+     * @brief Makes the component of type T for a new entity: the override of that type if there is one, or else a
+     * copy of the prototype's.
+     */
+    template<typename T, typename... Overrides>
+    T make(std::tuple<Overrides...>& overrides) const {
+        if constexpr(prototypeDetail::isOneOf<T, Overrides...>) {
+            return std::move(std::get<T>(overrides));
+        }
+        else {
+            return ComponentCopy<T>::copy(std::get<T>(_components));
+        }
+    }
+
+private:
+    std::tuple<Ts...> _components;
+
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include "SpatialHash.h"
+
+#include <algorithm>
+
+SpatialHash::SpatialHash(int cellSize) : _cellSize(std::max(cellSize, 1)) {}
+
+void SpatialHash::setCellSize(int cellSize) {
+    clear();
+    _cellSize = std::max(cellSize, 1);
+}
+
+void SpatialHash::update(Entity entity, const SDL_Rect& rect) {
+    std::uint32_t slot = entityHandle::getIndex(entity);
+    if(slot >= _records.size()) _records.resize(slot + 1);
+    Record& record = _records[slot];
+    CellRange cells = getCells(rect);
+    if(record.entity == entity && record.cells == cells) return;
+
+    if(record.entity != entityConstants::NULL_ENTITY) removeFromCells(record);
+    else ++_size;
+    record.entity = entity;
+    record.cells = cells;
+    addToCells(record);
+}
+
+void SpatialHash::remove(Entity entity) {
+    std::uint32_t slot = entityHandle::getIndex(entity);
+    if(slot >= _records.size() || _records[slot].entity != entity) return;
+    removeFromCells(_records[slot]);
+    _records[slot].entity = entityConstants::NULL_ENTITY;
+    --_size;
+}
+
+void SpatialHash::query(const SDL_Rect& rect, std::vector<Entity>& candidates) const {
+    candidates.clear();
+    CellRange area = getCells(rect);
+    for(int y = area.y0; y <= area.y1; ++y) {
+        for(int x = area.x0; x <= area.x1; ++x) {
+            const Cell* cell = findCell(x, y);
+            if(cell == nullptr) continue;
+            for(Entity entity : cell->entities) {
+                // An entity in several of these cells is only listed from the first one it shares with the rect
+                const CellRange& cells = _records[entityHandle::getIndex(entity)].cells;
+                if(x == std::max(cells.x0, area.x0) && y == std::max(cells.y0, area.y0)) {
+                    candidates.push_back(entity);
+                }
+            }
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](Entity a, Entity b) {
+        return entityHandle::getIndex(a) < entityHandle::getIndex(b);
+    });
+}
+
+void SpatialHash::queryPairs(std::vector<std::pair<Entity, Entity>>& pairs) const {
+    pairs.clear();
+    for(const Cell& cell : _cells) {
+        const std::vector<Entity>& entities = cell.entities;
+        if(entities.size() < 2) continue;
+        int x = cell.x;
+        int y = cell.y;
+        for(size_t i = 0; i < entities.size(); ++i) {
+            const CellRange& a = _records[entityHandle::getIndex(entities[i])].cells;
+            for(size_t j = i + 1; j < entities.size(); ++j) {
+                // Entities sharing several cells are only paired in the first of them
+                const CellRange& b = _records[entityHandle::getIndex(entities[j])].cells;
+                if(x != std::max(a.x0, b.x0) || y != std::max(a.y0, b.y0)) continue;
+                if(entityHandle::getIndex(entities[i]) < entityHandle::getIndex(entities[j])) {
+                    pairs.emplace_back(entities[i], entities[j]);
+                }
+                else {
+                    pairs.emplace_back(entities[j], entities[i]);
+                }
+            }
+        }
+    }
+}
+
+void SpatialHash::clear() {
+    _records.clear();
+    _cells.clear();
+    _cellIndices.clear();
+    _size = 0;
+}
+
+size_t SpatialHash::size() const {
+    return _size;
+}
+
+int SpatialHash::toCell(int coordinate) const {
+    // Rounds down for negative coordinates too
+    return coordinate >= 0 ? coordinate / _cellSize : (coordinate + 1) / _cellSize - 1;
+}
+
+SpatialHash::CellRange SpatialHash::getCells(const SDL_Rect& rect) const {
+    CellRange cells;
+    cells.x0 = toCell(rect.x);
+    cells.y0 = toCell(rect.y);
+    cells.x1 = toCell(rect.x + std::max(rect.w, 1) - 1);
+    cells.y1 = toCell(rect.y + std::max(rect.h, 1) - 1);
+    return cells;
+}
+
+std::uint64_t SpatialHash::getKey(int x, int y) {
+    return (std::uint64_t) (std::uint32_t) x << 32 | (std::uint32_t) y;
+}
+
+const SpatialHash::Cell* SpatialHash::findCell(int x, int y) const {
+    auto index = _cellIndices.find(getKey(x, y));
+    return (index == _cellIndices.end()) ? nullptr : &_cells[index->second];
+}
+
+void SpatialHash::addToCells(const Record& record) {
+    for(int y = record.cells.y0; y <= record.cells.y1; ++y) {
+        for(int x = record.cells.x0; x <= record.cells.x1; ++x) {
+            auto [index, added] = _cellIndices.try_emplace(getKey(x, y), (std::uint32_t) _cells.size());
+            if(added) _cells.push_back({x, y, {}});
+            _cells[index->second].entities.push_back(record.entity);
+        }
+    }
+}
+
+void SpatialHash::removeFromCells(const Record& record) {
+    for(int y = record.cells.y0; y <= record.cells.y1; ++y) {
+        for(int x = record.cells.x0; x <= record.cells.x1; ++x) {
+            auto index = _cellIndices.find(getKey(x, y));
+            if(index == _cellIndices.end()) continue;
+            std::vector<Entity>& entities = _cells[index->second].entities;
+            auto it = std::find(entities.begin(), entities.end(), record.entity);
+            if(it == entities.end()) continue;
+            *it = entities.back();
+            entities.pop_back();
+        }
+    }
+}
\ No newline at end of file
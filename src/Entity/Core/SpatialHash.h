@@ -0,0 +1,123 @@
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+#include "EntityConstants.h"
+#include "EntityHandle.h"
+
+#include <SDL.h>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Broadphase for entity vs entity collisions. Space is split into square cells, and every entity is listed
+ * in each cell its rect touches. Only entities sharing a cell with a rect can overlap it, so a query looks at a few
+ * cells instead of every entity.
+ *
+ * Entities are updated one at a time as they move, and only change cells when their rect crosses a cell border.
+ * Cells are kept in a hash map, so entities outside the level are fine.
+ */
+class SpatialHash {
+public:
+    explicit SpatialHash(int cellSize = 16);
+    ~SpatialHash() = default;
+
+    /**
+     * @brief Sets the size of a cell in pixels, e.g. the level's tile size. Removes every entity.
+     */
+    void setCellSize(int cellSize);
+
+    /**
+     * @brief Adds the entity, or moves it to the cells its new rect touches. An entity in the same slot with an
+     * older handle is replaced.
+     */
+    void update(Entity entity, const SDL_Rect& rect);
+
+    /**
+     * @brief Removes the entity. Does nothing if it is not in the hash.
+     */
+    void remove(Entity entity);
+
+    /**
+     * @brief Removes every entity the predicate returns true for.
+     */
+    template<typename Predicate>
+    void removeIf(Predicate predicate) {
+        for(auto& record : _records) {
+            if(record.entity != entityConstants::NULL_ENTITY && predicate(record.entity)) {
+                removeFromCells(record);
+                record.entity = entityConstants::NULL_ENTITY;
+                --_size;
+            }
+        }
+    }
+
+    /**
+     * @brief Finds the entities sharing a cell with the rect. These are only candidates, so their own rects still
+     * have to be checked against it. Each entity is listed once, sorted by entity slot so that the result does not
+     * depend on the order entities were added in.
+     *
+     * @param candidates Cleared, then filled with the candidates
+     */
+    void query(const SDL_Rect& rect, std::vector<Entity>& candidates) const;
+
+    /**
+     * @brief Finds every pair of entities sharing a cell, for checking everything against everything in one pass
+     * instead of one query per entity. Like query(), these are only candidates. Each pair is listed once with the lower
+     * entity slot first. Pairs are grouped by cell, in the order the cells were first used, so the same updates always
+     * give the same list. They are not sorted, since callers usually only keep a few.
+     *
+     * @param pairs Cleared, then filled with the candidate pairs
+     */
+    void queryPairs(std::vector<std::pair<Entity, Entity>>& pairs) const;
+
+    void clear();
+
+    /**
+     * @return The number of entities in the hash
+     */
+    size_t size() const;
+
+private:
+    // Inclusive range of cells a rect touches
+    struct CellRange {
+        int x0 = 0;
+        int y0 = 0;
+        int x1 = -1;
+        int y1 = -1;
+
+        bool operator==(const CellRange& rhs) const {
+            return x0 == rhs.x0 && y0 == rhs.y0 && x1 == rhs.x1 && y1 == rhs.y1;
+        }
+    };
+
+    struct Record {
+        Entity entity = entityConstants::NULL_ENTITY;
+        CellRange cells;
+    };
+
+    struct Cell {
+        int x = 0;
+        int y = 0;
+        std::vector<Entity> entities;
+    };
+
+    int toCell(int coordinate) const;
+    CellRange getCells(const SDL_Rect& rect) const;
+    static std::uint64_t getKey(int x, int y);
+    const Cell* findCell(int x, int y) const;
+    void addToCells(const Record& record);
+    void removeFromCells(const Record& record);
+
+    int _cellSize = 16;
+    // Indexed by entity slot
+    std::vector<Record> _records;
+    // Cells are kept in one array, so that queryPairs() walks them in order, with the map finding a cell's place in it
+    std::vector<Cell> _cells;
+    std::unordered_map<std::uint64_t, std::uint32_t> _cellIndices;
+    size_t _size = 0;
+
+};
+
+#endif
\ No newline at end of file
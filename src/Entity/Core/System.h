@@ -2,18 +2,27 @@
 #define SYSTEM_H
 
 #include "Audio.h"
+#include "ThreadPool.h"
+#include "EntitySet.h"
 
 #include <cstdint>
-#include <set>
 
-using Entity = std::uint16_t;
+using Entity = std::uint32_t;
+
+class EntityComponentSystem;
 
 class System {
 public:
     virtual void onEntityDelete(Entity entity) {};
 
-    std::set<Entity, std::greater<Entity>> _entities;
+    // The world the system was registered in. Set by EntityComponentSystem::registerSystem().
+    EntityComponentSystem* _ecs = nullptr;
+    // Entities whose signature matches the system's. Sort it before a loop, and walk it back to front if the loop can
+    // create or destroy entities.
+    EntitySet _entities;
     Audio* _audioPlayer = nullptr;
+    // Systems that split their work into batches run them here. Null means run everything on the calling thread.
+    ThreadPool* _threadPool = nullptr;
 };
 
 #endif
\ No newline at end of file
@@ -3,10 +3,12 @@
 
 #include "EntityConstants.h"
 #include "System.h"
+#include "EcsStats.h"
 
 #include <cstdint>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 #include <iostream>
 
 using Signature = std::bitset<entityConstants::MAX_COMPONENTS>;
@@ -42,16 +44,15 @@ public:
     }
 
     void entityDestroyed(Entity entity) {
-        for(auto keyValue : _systems) {
+        for(auto& keyValue : _systems) {
             keyValue.second->_entities.erase(entity);
         }
     }
 
     void entitySignatureChanged(Entity entity, Signature entitySignature) {
-        for(auto keyValue : _systems) {
-            auto type = keyValue.first;
-            auto system = keyValue.second;
-            auto systemSignature = _signatures[type];
+        for(auto& keyValue : _systems) {
+            auto system = keyValue.second.get();
+            const Signature& systemSignature = _signatures[keyValue.first];
             if((entitySignature & systemSignature) == systemSignature) {
                 system->_entities.insert(entity);
             }
@@ -61,6 +62,34 @@ public:
         }
     }
 
+    /**
+     * @brief Adds every system's name and number of entities.
+     */
+    void getStats(std::vector<SystemStats>& stats) const {
+        for(auto& keyValue : _systems) {
+            stats.push_back({EcsStats::typeName(keyValue.first), keyValue.second->_entities.size()});
+        }
+    }
+
+    /**
+     * @brief Copies every system's entity list, keyed by system type.
+     */
+    void captureEntities(std::unordered_map<const char *, EntitySet>& entities) const {
+        for(auto& keyValue : _systems) {
+            entities[keyValue.first] = keyValue.second->_entities;
+        }
+    }
+
+    /**
+     * @brief Puts back entity lists copied by captureEntities(). Systems missing from the copy are emptied.
+     */
+    void restoreEntities(const std::unordered_map<const char *, EntitySet>& entities) {
+        for(auto& keyValue : _systems) {
+            auto it = entities.find(keyValue.first);
+            keyValue.second->_entities = (it != entities.end()) ? it->second : EntitySet();
+        }
+    }
+
 private:
     std::unordered_map<const char *, Signature> _signatures;
     std::unordered_map<const char *, std::shared_ptr<System>> _systems;
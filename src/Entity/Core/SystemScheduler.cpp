@@ -0,0 +1,98 @@
+#include "SystemScheduler.h"
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+SystemScheduler::SystemScheduler(size_t workerCount) {
+    if(workerCount > 0) _threadPool = std::make_unique<ThreadPool>(workerCount);
+}
+
+void SystemScheduler::addTask(std::string name, SystemAccess access, std::function<void(float)> task) {
+    _tasks.push_back({access, std::move(task), {}, 0});
+    _timings.push_back({std::move(name), 0.f});
+    _graphDirty = true;
+}
+
+void SystemScheduler::run(float timescale) {
+    if(_singleThreaded || _threadPool == nullptr) {
+        for(size_t i = 0; i < _tasks.size(); ++i) {
+            runTask(i, timescale);
+        }
+        return;
+    }
+
+    if(_graphDirty) buildGraph();
+    if(_tasks.empty()) return;
+
+    _remainingTasks.store(_tasks.size());
+    for(size_t i = 0; i < _tasks.size(); ++i) {
+        _remainingDependencies[i].store(_tasks[i].dependencyCount);
+    }
+    for(size_t i = 0; i < _tasks.size(); ++i) {
+        if(_tasks[i].dependencyCount == 0) submitTask(i, timescale);
+    }
+    // Help out instead of blocking, since tasks are usually far shorter than a sleep
+    while(_remainingTasks.load() > 0) {
+        if(!_threadPool->tryRunJob()) std::this_thread::yield();
+    }
+}
+
+void SystemScheduler::setSingleThreaded(bool singleThreaded) {
+    _singleThreaded = singleThreaded;
+}
+
+bool SystemScheduler::isSingleThreaded() const {
+    return _singleThreaded || _threadPool == nullptr;
+}
+
+ThreadPool* SystemScheduler::getThreadPool() {
+    return isSingleThreaded() ? nullptr : _threadPool.get();
+}
+
+const std::vector<SystemScheduler::Timing>& SystemScheduler::getTimings() const {
+    return _timings;
+}
+
+void SystemScheduler::printTimings() const {
+    float total = 0.f;
+    for(auto& timing : _timings) {
+        std::cout << timing.name << ": " << timing.ms << "ms" << std::endl;
+        total += timing.ms;
+    }
+    std::cout << "Total: " << total << "ms" << (isSingleThreaded() ? " (single threaded)" : "") << std::endl;
+}
+
+void SystemScheduler::buildGraph() {
+    for(auto& task : _tasks) {
+        task.dependents.clear();
+        task.dependencyCount = 0;
+    }
+    // Every task waits for every earlier task it conflicts with, which keeps conflicting tasks in the order they were added
+    for(size_t later = 0; later < _tasks.size(); ++later) {
+        for(size_t earlier = 0; earlier < later; ++earlier) {
+            if(_tasks[earlier].access.conflictsWith(_tasks[later].access)) {
+                _tasks[earlier].dependents.push_back(later);
+                ++_tasks[later].dependencyCount;
+            }
+        }
+    }
+    _remainingDependencies = std::vector<std::atomic<size_t>>(_tasks.size());
+    _graphDirty = false;
+}
+
+void SystemScheduler::runTask(size_t index, float timescale) {
+    auto start = std::chrono::steady_clock::now();
+    _tasks[index].func(timescale);
+    _timings[index].ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void SystemScheduler::submitTask(size_t index, float timescale) {
+    _threadPool->submit([this, index, timescale] {
+        runTask(index, timescale);
+        for(size_t dependent : _tasks[index].dependents) {
+            if(_remainingDependencies[dependent].fetch_sub(1) == 1) submitTask(dependent, timescale);
+        }
+        _remainingTasks.fetch_sub(1);
+    });
+}
\ No newline at end of file
@@ -0,0 +1,137 @@
+#ifndef SYSTEM_SCHEDULER_H
+#define SYSTEM_SCHEDULER_H
+
+#include "EntityManager.h"
+#include "ComponentTypeRegistry.h"
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Declares what a scheduled task touches. Two tasks conflict if either writes a component the other reads
+ * or writes, if both record into the command buffer, or if either is exclusive. Exclusive tasks may do anything,
+ * including creating entities, adding components directly, playing audio, and touching state outside the ECS.
+ */
+struct SystemAccess {
+    Signature reads;
+    Signature writes;
+    bool commands = false;
+    bool exclusive = false;
+
+    template<typename... Ts>
+    SystemAccess& read() {
+        (reads.set(ComponentTypeRegistry::getType<Ts>()), ...);
+        return *this;
+    }
+
+    template<typename... Ts>
+    SystemAccess& write() {
+        (writes.set(ComponentTypeRegistry::getType<Ts>()), ...);
+        return *this;
+    }
+
+    /**
+     * @brief Marks the task as recording into the ECS command buffer, which isn't safe to share between threads.
+     */
+    SystemAccess& recordCommands() {
+        commands = true;
+        return *this;
+    }
+
+    /**
+     * @return Access that conflicts with every other task, so the task runs on its own
+     */
+    static SystemAccess all() {
+        SystemAccess access;
+        access.exclusive = true;
+        return access;
+    }
+
+    bool conflictsWith(const SystemAccess& other) const {
+        if(exclusive || other.exclusive) return true;
+        if(commands && other.commands) return true;
+        return (writes & (other.reads | other.writes)).any() || (reads & other.writes).any();
+    }
+};
+
+/**
+ * @brief Runs a frame's worth of tasks (usually one system update each) on a persistent thread pool. Each task
+ * waits for every earlier-added task it conflicts with, so the result is the same as running them one after
+ * another in the order they were added, while tasks that don't conflict run at the same time.
+ *
+ * The thread calling run() also runs tasks, so a scheduler with no worker threads runs everything on the
+ * calling thread in order. setSingleThreaded(true) does the same for debugging.
+ */
+class SystemScheduler {
+public:
+    struct Timing {
+        std::string name;
+        float ms = 0.f;
+    };
+
+    /**
+     * @param workerCount The number of threads to start in addition to the one calling run()
+     */
+    explicit SystemScheduler(size_t workerCount);
+    ~SystemScheduler() = default;
+
+    /**
+     * @brief Adds a task to the end of the frame. Tasks can't be removed, so add them once at startup.
+     */
+    void addTask(std::string name, SystemAccess access, std::function<void(float)> task);
+
+    /**
+     * @brief Runs every task once and returns when all of them are done.
+     */
+    void run(float timescale);
+
+    void setSingleThreaded(bool singleThreaded);
+
+    bool isSingleThreaded() const;
+
+    /**
+     * @brief Gets the pool tasks run on, for systems that want to split their own work into batches.
+     * 
+     * @return The pool, or nullptr if everything runs on the calling thread
+     */
+    ThreadPool* getThreadPool();
+
+    /**
+     * @brief Gets how long each task took in the last run(), in the order they were added.
+     */
+    const std::vector<Timing>& getTimings() const;
+
+    /**
+     * @brief Prints the timings of the last run() to the console.
+     */
+    void printTimings() const;
+
+private:
+    struct Task {
+        SystemAccess access;
+        std::function<void(float)> func;
+        // Later tasks that have to wait for this one
+        std::vector<size_t> dependents;
+        size_t dependencyCount = 0;
+    };
+
+    void buildGraph();
+    void runTask(size_t index, float timescale);
+    void submitTask(size_t index, float timescale);
+
+    std::unique_ptr<ThreadPool> _threadPool = nullptr;
+    std::vector<Task> _tasks;
+    std::vector<Timing> _timings;
+    // Dependencies each task is still waiting on during a parallel run
+    std::vector<std::atomic<size_t>> _remainingDependencies;
+    std::atomic<size_t> _remainingTasks = 0;
+    bool _graphDirty = false;
+    bool _singleThreaded = false;
+
+};
+
+#endif
\ No newline at end of file
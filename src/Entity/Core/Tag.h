@@ -0,0 +1,27 @@
+#ifndef TAG_H
+#define TAG_H
+
+#include <type_traits>
+
+/**
+ * @brief Components with no data, like PlayerComponent, are tags. Tags get no component array, archetype column or
+ * anything else per entity - having one is just the tag's bit being set in the entity's signature, so checking for
+ * a tag is a single bit test. Otherwise tags work like any other component: they can be added and removed, checked
+ * with hasComponent(), listed in views and filtered out with exclude(). Views can't check them for changes though,
+ * since there is nothing to change.
+ */
+template<typename T>
+constexpr bool isTag = std::is_empty_v<T>;
+
+/**
+ * @brief The one instance of a tag that getComponent() and views hand out for every entity that has it. There is
+ * nothing in it, so sharing it is safe.
+ */
+template<typename T>
+T& tagInstance() {
+    static_assert(isTag<T>, "Only tags share an instance");
+    static T instance;
+    return instance;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,337 @@
+#ifndef VIEW_H
+#define VIEW_H
+
+#include "ComponentManager.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief List of component types a view filters out. Only used as a template argument.
+ */
+template<typename... Ts>
+struct ExcludeList {};
+
+template<typename Exclude, typename... Ts>
+class BasicView;
+
+namespace viewDetail {
+    /**
+     * @return The position of U in Ts, or sizeof...(Ts) if it is not one of them
+     */
+    template<typename U, typename... Ts>
+    constexpr size_t indexOf() {
+        size_t index = 0;
+        bool found = false;
+        ((found = found || std::is_same_v<U, Ts>, index += found ? 0 : 1), ...);
+        return index;
+    }
+};
+
+/**
+ * @brief Iterates every entity that owns all of the included components and none of the excluded ones.
+ * Iteration is driven by whichever included component array is smallest, so the number of entities checked
+ * is bounded by the rarest component. Components from the driving array are read straight out of its packed
+ * storage, and every other component is found with a single lookup that doubles as the membership check.
+ *
+ * Tags never drive iteration, since they have no array. All of the included and excluded tags are checked at once
+ * by masking each entity's signature. A view of nothing but tags visits every entity with its first tag instead.
+ *
+ * Entities are visited back to front, so destroying the current entity inside the loop is safe. Destroying
+ * or removing components from any other entity while iterating is not.
+ *
+ * @tparam Excluded the components an entity must not have
+ * @tparam Ts the components an entity must have. Each type may only be listed once.
+ */
+template<typename... Excluded, typename... Ts>
+class BasicView<ExcludeList<Excluded...>, Ts...> {
+    static_assert(sizeof...(Ts) > 0, "A view must include at least one component");
+
+public:
+    class Iterator {
+    public:
+        Iterator(BasicView* view, size_t index) : _view(view), _index(index) {
+            seek();
+        }
+
+        /**
+         * @return The entity followed by a reference to each included component, in the order they were listed
+         */
+        std::tuple<Entity, Ts&...> operator*() const {
+            return std::tuple<Entity, Ts&...>(_entity, *std::get<Ts*>(_components)...);
+        }
+
+        Iterator& operator++() {
+            --_index;
+            seek();
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return _index == other._index;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return _index != other._index;
+        }
+
+    private:
+        // Steps back until the entity at _index - 1 passes the view's filters
+        void seek() {
+            while(_index > 0 && !_view->fetch(_index - 1, _entity, _components)) {
+                --_index;
+            }
+        }
+
+        BasicView* _view = nullptr;
+        size_t _index = 0;
+        Entity _entity = 0;
+        std::tuple<Ts*...> _components;
+    };
+
+    explicit BasicView(ComponentManager* componentManager) :
+        _componentManager(componentManager),
+        _entityManager(componentManager->getEntityManager()),
+        _pools(getPool<Ts>(componentManager)...),
+        _excludedPools(getPool<Excluded>(componentManager)...) {
+        (addTag<Ts>(_requiredTags), ...);
+        (addTag<Excluded>(_tagMask), ...);
+        _tagMask |= _requiredTags;
+        (chooseDriver(std::get<ComponentArray<Ts>*>(_pools)), ...);
+        if(_driver == nullptr) {
+            // Only tags, so every entity with the first one is a candidate
+            auto tagged = componentManager->getAllOf<std::tuple_element_t<0, std::tuple<Ts...>>>();
+            _tagged = std::make_shared<const std::vector<Entity>>(tagged.begin(), tagged.end());
+            _entities = _tagged.get();
+            _size = _tagged->size();
+        }
+    }
+
+    /**
+     * @brief Creates a copy of this view that also skips entities owning any of the given components.
+     *
+     * @return The filtered view
+     */
+    template<typename... Us>
+    BasicView<ExcludeList<Excluded..., Us...>, Ts...> exclude() const {
+        BasicView<ExcludeList<Excluded..., Us...>, Ts...> view(_componentManager);
+        view._filterChanged = _filterChanged;
+        view._changedSince = _changedSince;
+        std::copy(std::begin(_changedFilter), std::end(_changedFilter), std::begin(view._changedFilter));
+        return view;
+    }
+
+    /**
+     * @brief Creates a copy of this view that only visits entities where at least one of the given components was
+     * added or marked changed after the tick. A system that keeps derived data up to date stores the value
+     * EntityComponentSystem::advanceChangeTick() returns at the start of each run, and passes it here the next
+     * time, e.g. view<CollisionComponent, TransformComponent>().changed<TransformComponent>(_lastSync).
+     *
+     * @tparam Us the components to check, each of which must be one of the included components
+     * @return The filtered view
+     */
+    template<typename... Us>
+    BasicView changed(std::uint32_t tick) const {
+        static_assert(((viewDetail::indexOf<Us, Ts...>() < sizeof...(Ts)) && ...), "Only included components can be checked for changes");
+        static_assert(!(isTag<Us> || ...), "Tags can't be checked for changes");
+        BasicView view = *this;
+        view._filterChanged = true;
+        view._changedSince = tick;
+        ((view._changedFilter[viewDetail::indexOf<Us, Ts...>()] = true), ...);
+        return view;
+    }
+
+    /**
+     * @brief Calls func(entity, components...) for every entity in the view. Same order and rules as a range-for.
+     */
+    template<typename Func>
+    void each(Func func) {
+        Entity entity;
+        std::tuple<Ts*...> components;
+        for(size_t i = _size; i-- > 0;) {
+            if(fetch(i, entity, components)) {
+                func(entity, *std::get<Ts*>(components)...);
+            }
+        }
+    }
+
+    /**
+     * @brief Splits the view into batches of batchSize entities and calls func(batch, entity, components...) for every
+     * entity, running the batches in parallel on the pool. Entities may only touch their own components; anything
+     * shared (like entities to destroy) should be collected per batch and combined once this returns.
+     * Without a pool, or with a pool that has no workers, the batches run on the calling thread in each() order.
+     */
+    template<typename Func>
+    void parallelEach(ThreadPool* pool, size_t batchSize, Func func) {
+        size_t batches = batchCount(batchSize);
+        auto runBatch = [this, batchSize, &func](size_t batch) {
+            Entity entity;
+            std::tuple<Ts*...> components;
+            size_t end = std::min(_size, (batch + 1) * batchSize);
+            for(size_t i = end; i-- > batch * batchSize;) {
+                if(fetch(i, entity, components)) {
+                    func(batch, entity, *std::get<Ts*>(components)...);
+                }
+            }
+        };
+        if(pool == nullptr || pool->getThreadCount() == 0 || batches < 2) {
+            for(size_t batch = batches; batch-- > 0;) runBatch(batch);
+        }
+        else {
+            pool->parallelFor(batches, runBatch);
+        }
+    }
+
+    /**
+     * @return The number of batches parallelEach() splits the view into
+     */
+    size_t batchCount(size_t batchSize) const {
+        return (_size + batchSize - 1) / batchSize;
+    }
+
+    Iterator begin() {
+        return Iterator(this, _size);
+    }
+
+    Iterator end() {
+        return Iterator(this, 0);
+    }
+
+    /**
+     * @brief Gets the size of the driving array. This is an upper bound on the number of entities in the view.
+     *
+     * @return Number of entities that will be checked
+     */
+    size_t sizeHint() const {
+        return _size;
+    }
+
+private:
+    template<typename, typename...>
+    friend class BasicView;
+
+    /**
+     * @return The component's array, or nullptr for tags
+     */
+    template<typename T>
+    static ComponentArray<T>* getPool(ComponentManager* componentManager) {
+        if constexpr(isTag<T>) {
+            return nullptr;
+        }
+        else {
+            return componentManager->getComponentArray<T>();
+        }
+    }
+
+    template<typename T>
+    void addTag(Signature& signature) {
+        if constexpr(isTag<T>) signature.set(_componentManager->getComponentType<T>());
+    }
+
+    template<typename T>
+    void chooseDriver(ComponentArray<T>* pool) {
+        if(pool == nullptr) return;
+        if(_driver == nullptr || pool->size() < _size) {
+            _driver = pool;
+            _entities = &pool->getPackedEntities();
+            _size = pool->size();
+        }
+    }
+
+    template<typename T>
+    T* getFromPool(Entity entity, size_t index) {
+        if constexpr(isTag<T>) {
+            // Already checked against the signature
+            return &tagInstance<T>();
+        }
+        else {
+            ComponentArray<T>* pool = std::get<ComponentArray<T>*>(_pools);
+            if(static_cast<const void*>(pool) == _driver) return &pool->getDataAt(index);
+            return pool->tryGetData(entity);
+        }
+    }
+
+    template<typename T>
+    bool isExcluded(Entity entity) {
+        if constexpr(isTag<T>) {
+            // Already checked against the signature
+            return false;
+        }
+        else {
+            return std::get<ComponentArray<T>*>(_excludedPools)->hasComponent(entity);
+        }
+    }
+
+    /**
+     * @brief Looks up the entity at the given index of the driving array along with all of its included components.
+     *
+     * @return True if the entity has every included component, no excluded ones, and passes the change filter
+     */
+    bool fetch(size_t index, Entity& entity, std::tuple<Ts*...>& components) {
+        entity = (*_entities)[index];
+        if constexpr(HAS_TAGS) {
+            const Signature& signature = _entityManager->getLiveSignature(entity);
+            if((signature & _tagMask) != _requiredTags) return false;
+        }
+        if(_filterChanged && !hasChanged(entity, index, std::index_sequence_for<Ts...>{})) return false;
+        return (... && ((std::get<Ts*>(components) = getFromPool<Ts>(entity, index)) != nullptr)) &&
+            !(false || ... || isExcluded<Excluded>(entity));
+    }
+
+    template<size_t... Is>
+    bool hasChanged(Entity entity, size_t index, std::index_sequence<Is...>) const {
+        return (false || ... || (_changedFilter[Is] && getVersion(std::get<Is>(_pools), entity, index) > _changedSince));
+    }
+
+    template<typename T>
+    std::uint32_t getVersion(ComponentArray<T>* pool, Entity entity, size_t index) const {
+        if constexpr(isTag<T>) {
+            return 0;
+        }
+        else {
+            if(static_cast<const void*>(pool) == _driver) return pool->getVersionAt(index);
+            return pool->getVersion(entity);
+        }
+    }
+
+    static constexpr bool HAS_TAGS = (isTag<Ts> || ...) || (isTag<Excluded> || ...);
+
+    ComponentManager* _componentManager = nullptr;
+    const EntityManager* _entityManager = nullptr;
+    /**
+     * @brief Bits of every included and excluded tag, and of just the included ones. An entity passes the tag
+     * filters when its signature masked with _tagMask equals _requiredTags.
+     */
+    Signature _tagMask;
+    Signature _requiredTags;
+    // nullptr for tags
+    std::tuple<ComponentArray<Ts>*...> _pools;
+    std::tuple<ComponentArray<Excluded>*...> _excludedPools;
+    /**
+     * @brief The smallest included array. Its packed entity list decides which entities are visited.
+     */
+    const void* _driver = nullptr;
+    /**
+     * @brief The driving array's packed entities, held by reference so entities added mid-loop cannot leave it
+     * dangling. Only the first _size entries, the ones present when the view was made, are visited.
+     */
+    const std::vector<Entity>* _entities = nullptr;
+    size_t _size = 0;
+    // Entities to visit when the view only has tags, shared by copies of the view. _entities points here then.
+    std::shared_ptr<const std::vector<Entity>> _tagged = nullptr;
+    /**
+     * @brief Set by changed(). Which included components to check, and the tick they must have changed after.
+     */
+    bool _filterChanged = false;
+    bool _changedFilter[sizeof...(Ts)] = {};
+    std::uint32_t _changedSince = 0;
+
+};
+
+#endif
\ No newline at end of file
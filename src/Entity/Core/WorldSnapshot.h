@@ -0,0 +1,46 @@
+#ifndef WORLD_SNAPSHOT_H
+#define WORLD_SNAPSHOT_H
+
+#include "EntityManager.h"
+#include "ComponentStorage.h"
+#include "EntitySet.h"
+#include "System.h"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Copy of a whole EntityComponentSystem: every entity handle and signature, every component, every
+ * system's entity list and every watcher. Filled by EntityComponentSystem::captureSnapshot() and put back with
+ * EntityComponentSystem::restoreSnapshot().
+ *
+ * Components are copied with ComponentCopy, which is the copy constructor unless the component specialises it.
+ * ScriptComponent does, so that scripts with state of their own are cloned rather than shared with the live world.
+ */
+class WorldSnapshot {
+public:
+    WorldSnapshot() = default;
+    ~WorldSnapshot() = default;
+
+    WorldSnapshot(const WorldSnapshot&) = delete;
+    WorldSnapshot& operator=(const WorldSnapshot&) = delete;
+
+    /**
+     * @return True if nothing has been captured into the snapshot yet
+     */
+    bool empty() const {
+        return _componentManager == nullptr;
+    }
+
+private:
+    friend class EntityComponentSystem;
+
+    EntityManager _entityManager;
+    std::unique_ptr<ComponentStorage> _componentManager = nullptr;
+    std::unordered_map<const char *, EntitySet> _systemEntities;
+    std::unordered_map<Entity, std::vector<System*>> _watchers;
+
+};
+
+#endif
\ No newline at end of file
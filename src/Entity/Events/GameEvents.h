@@ -0,0 +1,48 @@
+#ifndef GAME_EVENTS_H
+#define GAME_EVENTS_H
+
+#include "PickupComponent.h"
+
+#include <cstdint>
+#include <string>
+
+using Entity = std::uint32_t;
+
+/**
+ * @brief Events published on the EntityComponentSystem's EventBus. GameState drains them at fixed points of the
+ * frame.
+ */
+
+/**
+ * @brief An entity started touching another one, e.g. the player reaching the goal.
+ */
+struct CollisionBeginEvent {
+    Entity entity = 0;
+    Entity other = 0;
+};
+
+/**
+ * @brief The player collected a pickup. The pickup is destroyed at the next command flush.
+ */
+struct PickupEvent {
+    Entity pickup = 0;
+    PickupType pickupType = PickupType::NOVAL;
+    // Empty if the pickup has nothing to say
+    std::string message = "";
+};
+
+/**
+ * @brief The player started touching a checkpoint.
+ */
+struct CheckpointActivatedEvent {
+    Entity checkpoint = 0;
+};
+
+/**
+ * @brief An entity ran out of hitpoints. Anything other than the player is destroyed at the next command flush.
+ */
+struct DeathEvent {
+    Entity entity = 0;
+};
+
+#endif
\ No newline at end of file
@@ -1,5 +1,5 @@
 #include "Checkpoint.h"
-#include "EntityRegistry.h"
+#include "EntityComponentSystem.h"
 #include "SpritesheetRegistry.h"
 // Components
 #include "ScriptComponent.h"
@@ -17,8 +17,7 @@ namespace {
         CheckpointOnActivatedScript() = default;
         ~CheckpointOnActivatedScript() = default;
 
-        void update(Entity owner, float timescale, Audio* audio) override {
-            auto ecs = EntityRegistry::getInstance();
+        void update(EntityComponentSystem* ecs, Entity owner, float timescale, Audio* audio) override {
             auto& state = ecs->getComponent<StateComponent>(owner);
             state.state = EntityState::ACTIVE;
             audio->playAudio(owner, AudioSound::CHECKPOINT_ACTIVATED, 1.f);
@@ -30,12 +29,11 @@ namespace {
 }
 
 namespace prefab {
-    Entity Checkpoint::create() {
-        return create({0.f, 0.f});
+    Entity Checkpoint::create(EntityComponentSystem* ecs) {
+        return create(ecs, {0.f, 0.f});
     }
 
-    Entity Checkpoint::create(strb::vec2 pos) {
-        auto ecs = EntityRegistry::getInstance();
+    Entity Checkpoint::create(EntityComponentSystem* ecs, strb::vec2 pos) {
         Entity ent = ecs->createEntity();
 
         ecs->addComponent<CheckpointComponent>(
@@ -6,7 +6,9 @@
 
 #include <cstdint>
 
-using Entity = std::uint16_t;
+using Entity = std::uint32_t;
+
+class EntityComponentSystem;
 
 namespace prefab {
     class Checkpoint {
@@ -14,8 +16,8 @@ namespace prefab {
         Checkpoint() = default;
         ~Checkpoint() = default;
 
-        static Entity create();
-        static Entity create(strb::vec2 pos);
+        static Entity create(EntityComponentSystem* ecs);
+        static Entity create(EntityComponentSystem* ecs, strb::vec2 pos);
 
     private:
         static SpritesheetPropertiesComponent createSpritesheetPropertiesComponent(Spritesheet* spritesheet);
@@ -1,6 +1,6 @@
 #include "Engine.h"
 
-#include "EntityRegistry.h"
+#include "EntityComponentSystem.h"
 #include "SpritesheetRegistry.h"
 // Components
 #include "PhysicsComponent.h"
@@ -22,8 +22,7 @@ namespace {
         EngineScript() = default;
         ~EngineScript() = default;
 
-        void update(Entity owner, float timescale, Audio* audio) override {
-            auto ecs = EntityRegistry::getInstance();
+        void update(EntityComponentSystem* ecs, Entity owner, float timescale, Audio* audio) override {
             auto& physics = ecs->getComponent<PhysicsComponent>(owner);
             auto& dir = ecs->getComponent<DirectionComponent>(owner);
             auto& collision = ecs->getComponent<CollisionComponent>(owner);
@@ -45,7 +44,7 @@ namespace {
             }
             
             if(dir.direction == Direction::WEST) {
-                float acceleration = (physics.touchingGround) ? physics.acceleration.x : physics.airAcceleration.x;
+                strb::real acceleration = (physics.touchingGround) ? physics.acceleration.x : physics.airAcceleration.x;
                 // check if acceleration is just past max velocity
                 if(physics.velocity.x - acceleration < physics.maxVelocity.x * -1 &&
                 physics.velocity.x - acceleration > physics.maxVelocity.x * -1 - acceleration) {
@@ -54,7 +53,7 @@ namespace {
                 if(physics.velocity.x >= physics.maxVelocity.x * -1) physics.velocity.x -= acceleration;
             }
             else if(dir.direction == Direction::EAST) {
-                float acceleration = (physics.touchingGround) ? physics.acceleration.x : physics.airAcceleration.x;
+                strb::real acceleration = (physics.touchingGround) ? physics.acceleration.x : physics.airAcceleration.x;
                 // check if acceleration is just past max velocity
                 if(physics.velocity.x + acceleration > physics.maxVelocity.x &&
                 physics.velocity.x + acceleration < physics.maxVelocity.x + acceleration) {
@@ -70,14 +69,25 @@ namespace {
 }
 
 namespace prefab {
-    Entity Engine::create() {
-        return create({0.f, 0.f});
+    Entity Engine::create(EntityComponentSystem* ecs) {
+        return create(ecs, {0.f, 0.f});
     }
 
-    Entity Engine::create(strb::vec2 pos) {
-        auto ecs = EntityRegistry::getInstance();
-        Entity ent = ecs->createEntity();
+    Entity Engine::create(EntityComponentSystem* ecs, strb::vec2 pos) {
+        static const EnginePrototype prototype = createPrototype();
+        return ecs->instantiate(prototype, TransformComponent{pos, pos});
+    }
 
+    std::vector<Entity> Engine::create(EntityComponentSystem* ecs, const std::vector<strb::vec2>& positions) {
+        std::vector<Entity> engines;
+        engines.reserve(positions.size());
+        for(auto pos : positions) {
+            engines.push_back(create(ecs, pos));
+        }
+        return engines;
+    }
+
+    Engine::EnginePrototype Engine::createPrototype() {
         PhysicsComponent physics;
         physics.airAcceleration = {5.f, 0.f};
         physics.acceleration = {15.f, 0.f};
@@ -86,34 +96,27 @@ namespace prefab {
         physics.frictionCoefficient = 10.f;
         physics.airFrictionCoefficient = 5.f;
 
-        ecs->addComponent<PhysicsComponent>(ent, physics);
-
         RenderComponent render;
         render.renderQuad = {0, 0, 16, 16};
-        
-        ecs->addComponent<RenderComponent>(ent, render);
 
         CollisionComponent collision;
         collision.collisionRect = {0, 0, 15, 15};
         collision.collisionRectOffset = {1, 1};
 
-        ecs->addComponent<CollisionComponent>(ent, collision);
-
-        ecs->addComponent<SpritesheetPropertiesComponent>(
-            ent,
-            createSpritesheetPropertiesComponent(SpritesheetRegistry::getSpritesheet(SpritesheetID::ENGINE_SPRITESHEET))
+        return EnginePrototype(
+            physics,
+            render,
+            collision,
+            createSpritesheetPropertiesComponent(SpritesheetRegistry::getSpritesheet(SpritesheetID::ENGINE_SPRITESHEET)),
+            AnimationComponent{},
+            DirectionComponent{Direction::EAST},
+            StateComponent{EntityState::RUNNING},
+            TransformComponent{},
+            ScriptComponent{std::make_shared<EngineScript>()},
+            HealthComponent{3},
+            EdgeCheckComponent{},
+            EnemyComponent{}
             );
-
-        ecs->addComponent<AnimationComponent>(ent, AnimationComponent{});
-        ecs->addComponent<DirectionComponent>(ent, DirectionComponent{Direction::EAST});
-        ecs->addComponent<StateComponent>(ent, StateComponent{EntityState::RUNNING});
-        ecs->addComponent<TransformComponent>(ent, {pos, pos});
-        ecs->addComponent<ScriptComponent>(ent, ScriptComponent{std::make_shared<EngineScript>()});
-        ecs->addComponent<HealthComponent>(ent, HealthComponent{3});
-        ecs->addComponent<EdgeCheckComponent>(ent, EdgeCheckComponent{});
-        ecs->addComponent<EnemyComponent>(ent, EnemyComponent{});
-
-        return ent;
     }
 
     SpritesheetPropertiesComponent Engine::createSpritesheetPropertiesComponent(Spritesheet* spritesheet) {
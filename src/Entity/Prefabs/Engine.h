@@ -2,11 +2,26 @@
 #define ENGINE_H
 
 #include "vec2.h"
+#include "Prototype.h"
+#include "PhysicsComponent.h"
+#include "RenderComponent.h"
+#include "CollisionComponent.h"
 #include "SpritesheetPropertiesComponent.h"
+#include "AnimationComponent.h"
+#include "DirectionComponent.h"
+#include "StateComponent.h"
+#include "TransformComponent.h"
+#include "ScriptComponent.h"
+#include "HealthComponent.h"
+#include "EdgeCheckComponent.h"
+#include "EnemyComponent.h"
 
 #include <cstdint>
+#include <vector>
 
-using Entity = std::uint16_t;
+using Entity = std::uint32_t;
+
+class EntityComponentSystem;
 
 namespace prefab {
     class Engine {
@@ -14,10 +29,35 @@ namespace prefab {
         Engine() = default;
         ~Engine() = default;
 
-        static Entity create();
-        static Entity create(strb::vec2 pos);
+        static Entity create(EntityComponentSystem* ecs);
+        static Entity create(EntityComponentSystem* ecs, strb::vec2 pos);
+        /**
+         * @brief Creates an engine at each position.
+         * 
+         * @return The engines, in the same order as the positions
+         */
+        static std::vector<Entity> create(EntityComponentSystem* ecs, const std::vector<strb::vec2>& positions);
 
     private:
+        using EnginePrototype = Prototype<
+            PhysicsComponent,
+            RenderComponent,
+            CollisionComponent,
+            SpritesheetPropertiesComponent,
+            AnimationComponent,
+            DirectionComponent,
+            StateComponent,
+            TransformComponent,
+            ScriptComponent,
+            HealthComponent,
+            EdgeCheckComponent,
+            EnemyComponent>;
+
+        /**
+         * @brief Builds the components every engine starts with. Called once, the first time an engine is created.
+         * Engines share one EngineScript, since it has no state.
+         */
+        static EnginePrototype createPrototype();
         static SpritesheetPropertiesComponent createSpritesheetPropertiesComponent(Spritesheet* spritesheet);
 
         static const int NUM_OF_RUN_FRAMES = 2;
@@ -1,5 +1,5 @@
 #include "Goal.h"
-#include "EntityRegistry.h"
+#include "EntityComponentSystem.h"
 #include "SpritesheetRegistry.h"
 // Components
 #include "ScriptComponent.h"
@@ -16,8 +16,7 @@ namespace {
         GoalOnActivatedScript() = default;
         ~GoalOnActivatedScript() = default;
 
-        void update(Entity owner, float timescale, Audio* audio) override {
-            auto ecs = EntityRegistry::getInstance();
+        void update(EntityComponentSystem* ecs, Entity owner, float timescale, Audio* audio) override {
             auto& state = ecs->getComponent<StateComponent>(owner);
             state.state = EntityState::ACTIVE;
 
@@ -33,12 +32,11 @@ namespace {
 }
 
 namespace prefab {
-    Entity Goal::create() {
-        return create({0.f, 0.f});
+    Entity Goal::create(EntityComponentSystem* ecs) {
+        return create(ecs, {0.f, 0.f});
     }
 
-    Entity Goal::create(strb::vec2 pos) {
-        auto ecs = EntityRegistry::getInstance();
+    Entity Goal::create(EntityComponentSystem* ecs, strb::vec2 pos) {
         Entity ent = ecs->createEntity();
 
         ecs->addComponent<GoalComponent>(
@@ -1,5 +1,5 @@
 #include "Pickup.h"
-#include "EntityRegistry.h"
+#include "EntityComponentSystem.h"
 #include "SpritesheetRegistry.h"
 // Components
 #include "PhysicsComponent.h"
@@ -23,13 +23,12 @@ namespace PickupScript {
         PickupIdleScript() = default;
         ~PickupIdleScript() = default;
 
-        void update(Entity owner, float timescale, Audio* audio) override {
-            auto ecs = EntityRegistry::getInstance();
+        void update(EntityComponentSystem* ecs, Entity owner, float timescale, Audio* audio) override {
             auto& physics = ecs->getComponent<PhysicsComponent>(owner);
 
             // after extended time this gets out of sync so we reset timer after every cycle
-            float halfPi = 1.5707963267948966192313216916398f;
-            physics.velocity.y += std::cos(_timer * halfPi) / 4.f;
+            strb::real halfPi = 1.5707963267948966192313216916398f;
+            physics.velocity.y += strb::cos(_timer * halfPi) / 4.f;
             _timer += timescale;
             if(_timer >= 4) {
                 resetIdleTimer();
@@ -41,8 +40,12 @@ namespace PickupScript {
             _timer = 0;
         }
 
+        std::shared_ptr<IScript> clone() const override {
+            return std::make_shared<PickupIdleScript>(*this);
+        }
+
     private:
-        float _timer = 0;    
+        strb::real _timer = 0;    
 
     };
 
@@ -51,8 +54,7 @@ namespace PickupScript {
         WeaponPickupScript() = default;
         ~WeaponPickupScript() = default;
 
-        void update(Entity owner, float timescale, Audio* audio) override {
-            auto ecs = EntityRegistry::getInstance();
+        void update(EntityComponentSystem* ecs, Entity owner, float timescale, Audio* audio) override {
             Entity player = ecs->getAllOf<PlayerComponent>().front();
             ecs->addComponent<WeaponComponent>(player, WeaponComponent{});
         }
@@ -65,8 +67,7 @@ namespace PickupScript {
         JumpPickupScript() = default;
         ~JumpPickupScript() = default;
 
-        void update(Entity owner, float timescale, Audio* audio) override {
-            auto ecs = EntityRegistry::getInstance();
+        void update(EntityComponentSystem* ecs, Entity owner, float timescale, Audio* audio) override {
             Entity player = ecs->getAllOf<PlayerComponent>().front();
             auto& input = ecs->getComponent<InputComponent>(player);
             if(std::find(input.allowedInputs.begin(), input.allowedInputs.end(), InputEvent::JUMP) == input.allowedInputs.end()) {
@@ -82,8 +83,7 @@ namespace PickupScript {
         BootsPickupScript() = default;
         ~BootsPickupScript() = default;
 
-        void update(Entity owner, float timescale, Audio* audio) override {
-            auto ecs = EntityRegistry::getInstance();
+        void update(EntityComponentSystem* ecs, Entity owner, float timescale, Audio* audio) override {
             Entity player = ecs->getAllOf<PlayerComponent>().front();
             ecs->addComponent<BootsComponent>(player, BootsComponent{});
         }
@@ -96,8 +96,7 @@ namespace PickupScript {
         WalljumpPickupScript() = default;
         ~WalljumpPickupScript() = default;
 
-        void update(Entity owner, float timescale, Audio* audio) override {
-            auto ecs = EntityRegistry::getInstance();
+        void update(EntityComponentSystem* ecs, Entity owner, float timescale, Audio* audio) override {
             Entity player = ecs->getAllOf<PlayerComponent>().front();
             ecs->addComponent<WalljumpComponent>(player, WalljumpComponent{});
         }
@@ -108,16 +107,25 @@ namespace PickupScript {
 
 namespace prefab
 {
-    Entity Pickup::create() {
-        return Pickup::create({0.f, 0.f}, PickupType::NOVAL);
+    Entity Pickup::create(EntityComponentSystem* ecs) {
+        return Pickup::create(ecs, {0.f, 0.f}, PickupType::NOVAL);
     }
 
-    Entity Pickup::create(strb::vec2 pos, PickupType pickupType) {
-        auto ecs = EntityRegistry::getInstance();
-        Entity ent = ecs->createEntity();
+    Entity Pickup::create(EntityComponentSystem* ecs, strb::vec2 pos, PickupType pickupType) {
+        // Indexed by pickup type + 1, so that NOVAL gets one too
+        static const PickupPrototype prototypes[] = {
+            createPrototype(PickupType::NOVAL),
+            createPrototype(PickupType::WEAPON),
+            createPrototype(PickupType::JUMP),
+            createPrototype(PickupType::BOOTS),
+            createPrototype(PickupType::WALLJUMP)
+        };
+        return ecs->instantiate(prototypes[(int) pickupType + 1], TransformComponent{pos, pos});
+    }
 
+    Pickup::PickupPrototype Pickup::createPrototype(PickupType pickupType) {
         PickupComponent pickupComp;
-        SpritesheetID spritesheetId;
+        SpritesheetID spritesheetId = SpritesheetID::NOVAL;
         pickupComp.pickupType = pickupType;
         switch(pickupType) {
             case PickupType::WEAPON:
@@ -143,11 +151,6 @@ namespace prefab
             default:
                 break;
         }
-        ecs->addComponent<PickupComponent>(ent, pickupComp);
-        ecs->addComponent<SpritesheetPropertiesComponent>(
-            ent,
-            createSpritesheetPropertiesComponent(SpritesheetRegistry::getSpritesheet(spritesheetId))
-            );
         
         PhysicsComponent physics;
         physics.airAcceleration = {0.f, 0.f};
@@ -159,24 +162,23 @@ namespace prefab
         physics.gravity = 0.f;
         physics.touchingGround = false;
 
-        ecs->addComponent<PhysicsComponent>(ent, physics);
-
         RenderComponent render;
         render.renderQuad = {0, 0, 16, 16};
-        
-        ecs->addComponent<RenderComponent>(ent, render);
 
         CollisionComponent collision;
         collision.collisionRect = {0, 0, 14, 14};
         collision.collisionRectOffset = {1, 1};
 
-        ecs->addComponent<CollisionComponent>(ent, collision);
-
-        ecs->addComponent<TransformComponent>(ent, {pos, pos});
-
-        ecs->addComponent<ScriptComponent>(ent, ScriptComponent{std::make_shared<PickupScript::PickupIdleScript>()});
-
-        return ent;
+        // PickupIdleScript has state, so every pickup gets its own copy of it
+        return PickupPrototype(
+            pickupComp,
+            createSpritesheetPropertiesComponent(SpritesheetRegistry::getSpritesheet(spritesheetId)),
+            physics,
+            render,
+            collision,
+            TransformComponent{},
+            ScriptComponent{std::make_shared<PickupScript::PickupIdleScript>()}
+            );
     }
 
     SpritesheetPropertiesComponent Pickup::createSpritesheetPropertiesComponent(Spritesheet* spritesheet) {
@@ -2,12 +2,20 @@
 #define PICKUP_H
 
 #include "vec2.h"
-#include "SpritesheetPropertiesComponent.h"
+#include "Prototype.h"
 #include "PickupComponent.h"
+#include "SpritesheetPropertiesComponent.h"
+#include "PhysicsComponent.h"
+#include "RenderComponent.h"
+#include "CollisionComponent.h"
+#include "TransformComponent.h"
+#include "ScriptComponent.h"
 
 #include <cstdint>
 
-using Entity = std::uint16_t;
+using Entity = std::uint32_t;
+
+class EntityComponentSystem;
 
 namespace prefab {
     class Pickup {
@@ -15,10 +23,24 @@ namespace prefab {
         Pickup() = default;
         ~Pickup() = default;
 
-        static Entity create();
-        static Entity create(strb::vec2 pos, PickupType pickupType);
+        static Entity create(EntityComponentSystem* ecs);
+        static Entity create(EntityComponentSystem* ecs, strb::vec2 pos, PickupType pickupType);
 
     private:
+        using PickupPrototype = Prototype<
+            PickupComponent,
+            SpritesheetPropertiesComponent,
+            PhysicsComponent,
+            RenderComponent,
+            CollisionComponent,
+            TransformComponent,
+            ScriptComponent>;
+
+        /**
+         * @brief Builds the components every pickup of the type starts with. Called once per type, the first time
+         * a pickup is created.
+         */
+        static PickupPrototype createPrototype(PickupType pickupType);
         static SpritesheetPropertiesComponent createSpritesheetPropertiesComponent(Spritesheet* spritesheet);
 
     };
@@ -1,6 +1,6 @@
 #include "Player.h"
 
-#include "EntityRegistry.h"
+#include "EntityComponentSystem.h"
 #include "SpritesheetRegistry.h"
 // Components
 #include "PlayerComponent.h"
@@ -23,8 +23,7 @@ namespace {
         PlayerScript() = default;
         ~PlayerScript() = default;
 
-        void update(Entity owner, float timescale, Audio* audio) override {
-            auto ecs = EntityRegistry::getInstance();
+        void update(EntityComponentSystem* ecs, Entity owner, float timescale, Audio* audio) override {
             auto& state = ecs->getComponent<StateComponent>(owner);
             auto& physics = ecs->getComponent<PhysicsComponent>(owner);
             if(physics.touchingGround) {
@@ -44,21 +43,20 @@ namespace {
 }
 
 namespace prefab {
-    Entity Player::create() {
-        return create({0.f, 0.f});
+    Entity Player::create(EntityComponentSystem* ecs) {
+        return create(ecs, {0.f, 0.f});
     }
 
-    Entity Player::create(strb::vec2 pos) {
-        auto ecs = EntityRegistry::getInstance();
-        Entity ent = ecs->createEntity();
-
-        ecs->addComponent<PlayerComponent>(ent, PlayerComponent{});
+    Entity Player::create(EntityComponentSystem* ecs, strb::vec2 pos) {
+        static const PlayerPrototype prototype = createPrototype();
+        return ecs->instantiate(prototype, TransformComponent{pos, pos});
+    }
 
+    Player::PlayerPrototype Player::createPrototype() {
         InputComponent input = {{
             InputEvent::LEFT,
             InputEvent::RIGHT
         }};
-        ecs->addComponent<InputComponent>(ent, input);
 
         PhysicsComponent physics;
         physics.airAcceleration = {25.f, 0.f};
@@ -68,32 +66,27 @@ namespace prefab {
         physics.frictionCoefficient = 30.f;
         physics.airFrictionCoefficient = 5.f;
 
-        ecs->addComponent<PhysicsComponent>(ent, physics);
-
         RenderComponent render;
         render.renderQuad = {0, 0, 24, 24};
-        
-        ecs->addComponent<RenderComponent>(ent, render);
 
         CollisionComponent collision;
         collision.collisionRect = {0, 0, 8, 20};
         collision.collisionRectOffset = {8, 4};
 
-        ecs->addComponent<CollisionComponent>(ent, collision);
-
-        ecs->addComponent<SpritesheetPropertiesComponent>(
-            ent,
-            createSpritesheetPropertiesComponent(SpritesheetRegistry::getSpritesheet(SpritesheetID::PLAYER_SPRITESHEET))
+        return PlayerPrototype(
+            PlayerComponent{},
+            input,
+            physics,
+            render,
+            collision,
+            createSpritesheetPropertiesComponent(SpritesheetRegistry::getSpritesheet(SpritesheetID::PLAYER_SPRITESHEET)),
+            AnimationComponent{},
+            DirectionComponent{Direction::EAST},
+            StateComponent{EntityState::IDLE},
+            TransformComponent{},
+            ScriptComponent{std::make_shared<PlayerScript>()},
+            HealthComponent{1}
             );
-
-        ecs->addComponent<AnimationComponent>(ent, AnimationComponent{});
-        ecs->addComponent<DirectionComponent>(ent, DirectionComponent{Direction::EAST});
-        ecs->addComponent<StateComponent>(ent, StateComponent{EntityState::IDLE});
-        ecs->addComponent<TransformComponent>(ent, {pos, pos});
-        ecs->addComponent<ScriptComponent>(ent, ScriptComponent{std::make_shared<PlayerScript>()});
-        ecs->addComponent<HealthComponent>(ent, HealthComponent{1});
-
-        return ent;
     }
 
     SpritesheetPropertiesComponent Player::createSpritesheetPropertiesComponent(Spritesheet* spritesheet) {
@@ -2,11 +2,25 @@
 #define PLAYER_H
 
 #include "vec2.h"
+#include "Prototype.h"
+#include "PlayerComponent.h"
+#include "InputComponent.h"
+#include "PhysicsComponent.h"
+#include "RenderComponent.h"
+#include "CollisionComponent.h"
 #include "SpritesheetPropertiesComponent.h"
+#include "AnimationComponent.h"
+#include "DirectionComponent.h"
+#include "StateComponent.h"
+#include "TransformComponent.h"
+#include "ScriptComponent.h"
+#include "HealthComponent.h"
 
 #include <cstdint>
 
-using Entity = std::uint16_t;
+using Entity = std::uint32_t;
+
+class EntityComponentSystem;
 
 namespace prefab {
     class Player {
@@ -14,10 +28,28 @@ namespace prefab {
         Player() = default;
         ~Player() = default;
 
-        static Entity create();
-        static Entity create(strb::vec2 pos);
+        static Entity create(EntityComponentSystem* ecs);
+        static Entity create(EntityComponentSystem* ecs, strb::vec2 pos);
 
     private:
+        using PlayerPrototype = Prototype<
+            PlayerComponent,
+            InputComponent,
+            PhysicsComponent,
+            RenderComponent,
+            CollisionComponent,
+            SpritesheetPropertiesComponent,
+            AnimationComponent,
+            DirectionComponent,
+            StateComponent,
+            TransformComponent,
+            ScriptComponent,
+            HealthComponent>;
+
+        /**
+         * @brief Builds the components the player starts with. Called once, the first time the player is created.
+         */
+        static PlayerPrototype createPrototype();
         static SpritesheetPropertiesComponent createSpritesheetPropertiesComponent(Spritesheet* spritesheet);
 
         static const int NUM_OF_IDLE_FRAMES = 6;
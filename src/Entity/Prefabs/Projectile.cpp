@@ -1,5 +1,5 @@
 #include "Projectile.h"
-#include "EntityRegistry.h"
+#include "EntityComponentSystem.h"
 #include "SpritesheetRegistry.h"
 // Components
 #include "TransformComponent.h"
@@ -10,25 +10,42 @@
 #include "AnimationComponent.h"
 
 namespace prefab {
-    Entity Projectile::create() {
-        return create({0.f, 0.f}, Direction::EAST);
+    Entity Projectile::create(EntityComponentSystem* ecs) {
+        return create(ecs, {0.f, 0.f}, Direction::EAST);
     }
 
-    Entity Projectile::create(strb::vec2 pos, Direction shotDir) {
-        auto ecs = EntityRegistry::getInstance();
-        Entity ent = ecs->createEntity();
+    Entity Projectile::create(EntityComponentSystem* ecs, strb::vec2 pos, Direction shotDir) {
+        static const ProjectilePrototype prototype = createPrototype();
 
+        RenderComponent render = prototype.get<RenderComponent>();
+        render.renderQuad.x = (int) pos.x;
+        render.renderQuad.y = (int) pos.y;
+
+        CollisionComponent collision = prototype.get<CollisionComponent>();
+        collision.collisionRect.x = (int) pos.x;
+        collision.collisionRect.y = (int) pos.y;
+
+        PhysicsComponent physics = prototype.get<PhysicsComponent>();
+        strb::real coefficient = (shotDir == Direction::WEST) ? -1.f : 1.f;
+        physics.velocity.x = 280.f * coefficient;
+
+        return ecs->instantiate(
+            prototype,
+            render,
+            collision,
+            physics,
+            TransformComponent{pos, pos}
+            );
+    }
+
+    Projectile::ProjectilePrototype Projectile::createPrototype() {
         RenderComponent render;
-        render.renderQuad = {(int) pos.x, (int) pos.y, 8, 8};
-        
-        ecs->addComponent<RenderComponent>(ent, render);
+        render.renderQuad = {0, 0, 8, 8};
 
         CollisionComponent collision;
-        collision.collisionRect = {(int) pos.x, (int) pos.y, 4, 4};
+        collision.collisionRect = {0, 0, 4, 4};
         collision.collisionRectOffset = {4, 4};
         
-        ecs->addComponent<CollisionComponent>(ent, collision);
-        
         PhysicsComponent physics;
         physics.airAcceleration = {0.f, 0.f};
         physics.acceleration = {0.f, 0.f};
@@ -38,22 +55,16 @@ namespace prefab {
         physics.airFrictionCoefficient = 0.f;
         physics.gravity = 0.f;
         physics.touchingGround = false;
-        float coefficient = (shotDir == Direction::WEST) ? -1.f : 1.f;
-        physics.velocity.x = 280.f * coefficient;
 
-        ecs->addComponent<PhysicsComponent>(ent, physics);
-
-        ecs->addComponent<AnimationComponent>(ent, AnimationComponent{});
-        ecs->addComponent<TransformComponent>(ent, TransformComponent{pos, pos});
-        ecs->addComponent<ProjectileComponent>(ent, ProjectileComponent{});
-        ecs->addComponent<ProjectileComponent>(ent, ProjectileComponent{});
-
-        ecs->addComponent<SpritesheetPropertiesComponent>(
-            ent,
+        return ProjectilePrototype(
+            render,
+            collision,
+            physics,
+            AnimationComponent{},
+            TransformComponent{},
+            ProjectileComponent{},
             createSpritesheetPropertiesComponent(SpritesheetRegistry::getSpritesheet(SpritesheetID::PROJECTILE))
             );
-        
-        return ent;
     }
     
     SpritesheetPropertiesComponent Projectile::createSpritesheetPropertiesComponent(Spritesheet* spritesheet) {
@@ -2,11 +2,20 @@
 #define PROJECTILE_H
 
 #include "vec2.h"
+#include "Prototype.h"
+#include "RenderComponent.h"
+#include "CollisionComponent.h"
+#include "PhysicsComponent.h"
+#include "AnimationComponent.h"
+#include "TransformComponent.h"
+#include "ProjectileComponent.h"
 #include "SpritesheetPropertiesComponent.h"
 
 #include <cstdint>
 
-using Entity = std::uint16_t;
+using Entity = std::uint32_t;
+
+class EntityComponentSystem;
 
 namespace prefab {
     class Projectile {
@@ -14,10 +23,23 @@ namespace prefab {
         Projectile() = default;
         ~Projectile() = default;
 
-        static Entity create();
-        static Entity create(strb::vec2 pos, Direction shotDir);
+        static Entity create(EntityComponentSystem* ecs);
+        static Entity create(EntityComponentSystem* ecs, strb::vec2 pos, Direction shotDir);
 
     private:
+        using ProjectilePrototype = Prototype<
+            RenderComponent,
+            CollisionComponent,
+            PhysicsComponent,
+            AnimationComponent,
+            TransformComponent,
+            ProjectileComponent,
+            SpritesheetPropertiesComponent>;
+
+        /**
+         * @brief Builds the components every projectile starts with. Called once, the first time a projectile is created.
+         */
+        static ProjectilePrototype createPrototype();
         static SpritesheetPropertiesComponent createSpritesheetPropertiesComponent(Spritesheet* spritesheet);
 
         static const int NUM_OF_ACTIVE_FRAMES = 4;
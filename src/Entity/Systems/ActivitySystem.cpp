@@ -0,0 +1,29 @@
+#include "ActivitySystem.h"
+#include "EntityComponentSystem.h"
+#include "TransformComponent.h"
+#include "DormantComponent.h"
+
+void ActivitySystem::update(SDL_Rect cameraView) {
+    _entities.sort();
+    strb::real left = cameraView.x - _margin;
+    strb::real top = cameraView.y - _margin;
+    strb::real right = cameraView.x + cameraView.w + _margin;
+    strb::real bottom = cameraView.y + cameraView.h + _margin;
+    // Adding or removing the tag doesn't change who this system tracks, so the list is safe to walk
+    for(Entity ent : _entities) {
+        auto& transform = _ecs->getComponent<TransformComponent>(ent);
+        bool active = transform.position.x >= left && transform.position.x <= right &&
+            transform.position.y >= top && transform.position.y <= bottom;
+        bool dormant = _ecs->hasComponent<DormantComponent>(ent);
+        if(active && dormant) {
+            _ecs->removeComponent<DormantComponent>(ent);
+        }
+        else if(!active && !dormant) {
+            _ecs->addComponent<DormantComponent>(ent, DormantComponent{});
+        }
+    }
+}
+
+void ActivitySystem::setMargin(int margin) {
+    _margin = margin;
+}
\ No newline at end of file
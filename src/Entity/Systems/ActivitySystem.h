@@ -0,0 +1,36 @@
+#ifndef ACTIVITY_SYSTEM_H
+#define ACTIVITY_SYSTEM_H
+
+#include "System.h"
+
+#include <SDL.h>
+
+/**
+ * @brief Puts entities to sleep when they are far from the camera, so that a level full of enemies only costs what
+ * is near the player. Entities outside the camera's view grown by the margin get a DormantComponent, and lose it
+ * again once the view comes back within the margin.
+ */
+class ActivitySystem : public System {
+public:
+    ActivitySystem() = default;
+    ~ActivitySystem() = default;
+
+    /**
+     * @brief Adds or removes the dormant tag on every entity. Only reads the camera's view and the entities'
+     * positions, so the same tick always wakes the same entities.
+     * 
+     * @param cameraView The part of the level the camera shows, in pixels
+     */
+    void update(SDL_Rect cameraView);
+
+    /**
+     * @brief Sets how far outside the camera's view entities stay awake, in pixels.
+     */
+    void setMargin(int margin);
+
+private:
+    int _margin = 0;
+
+};
+
+#endif
\ No newline at end of file
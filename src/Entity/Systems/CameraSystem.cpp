@@ -1,12 +1,12 @@
 #include "CameraSystem.h"
 
 void CameraSystem::update(float timescale) {
-    float xOffsetDiff = _goalCameraOffset.x - _currentCameraOffset.x;
-    float yOffsetDiff = _goalCameraOffset.y - _currentCameraOffset.y;
+    strb::real xOffsetDiff = _goalCameraOffset.x - _currentCameraOffset.x;
+    strb::real yOffsetDiff = _goalCameraOffset.y - _currentCameraOffset.y;
     // X Offset
     if(_currentCameraOffset.x < _goalCameraOffset.x) {
-        if(std::abs(xOffsetDiff) > _maxCameraDistance) {
-            if(std::abs(xOffsetDiff) > _maxCameraDistance + 2) {
+        if(strb::abs(xOffsetDiff) > _maxCameraDistance) {
+            if(strb::abs(xOffsetDiff) > _maxCameraDistance + 2) {
                 _delta.x = xOffsetDiff / _maxCameraDistance * _maxSpeed * timescale;
             }
             else {
@@ -18,8 +18,8 @@ void CameraSystem::update(float timescale) {
         }
     }
     else {
-        if(std::abs(xOffsetDiff) > _maxCameraDistance) {
-            if(std::abs(xOffsetDiff) > _maxCameraDistance + 2) {
+        if(strb::abs(xOffsetDiff) > _maxCameraDistance) {
+            if(strb::abs(xOffsetDiff) > _maxCameraDistance + 2) {
                 _delta.x = xOffsetDiff / _maxCameraDistance * _maxSpeed * timescale;
             }
             else {
@@ -53,27 +53,27 @@ void CameraSystem::update(float timescale) {
     }
 }
 
-void CameraSystem::setGoalCameraOffset(float x, float y) {
+void CameraSystem::setGoalCameraOffset(strb::real x, strb::real y) {
     _goalCameraOffset = {x, y};
 }
 
-void CameraSystem::setCurrentCameraOffset(float x, float y) {
+void CameraSystem::setCurrentCameraOffset(strb::real x, strb::real y) {
     _currentCameraOffset = {x, y};
 }
 
 void CameraSystem::setGameSize(int x, int y) {
-    _gameSize = {(float) x, (float) y};
+    _gameSize = {(strb::real) x, (strb::real) y};
 }
 
 void CameraSystem::setLevelSize(int x, int y) {
-    _levelSize = {(float) x, (float) y};
+    _levelSize = {(strb::real) x, (strb::real) y};
 }
 
-void CameraSystem::setMaxSpeed(float speed) {
+void CameraSystem::setMaxSpeed(strb::real speed) {
     _maxSpeed = speed;
 }
 
-void CameraSystem::setAcceleration(float acceleration) {
+void CameraSystem::setAcceleration(strb::real acceleration) {
     _cameraAcceleration = acceleration;
 }
 
@@ -1,6 +1,5 @@
 #include "CollisionSystem.h"
-#include "EntityRegistry.h"
-#include "vec2.h"
+#include "EntityComponentSystem.h"
 #include "CollisionComponent.h"
 #include "PhysicsComponent.h"
 #include "TransformComponent.h"
@@ -14,57 +13,63 @@
 #include "EdgeCheckComponent.h"
 #include "PlayerComponent.h"
 #include "EnemyComponent.h"
+#include "DormantComponent.h"
+#include "GameEvents.h"
+#include "EntityHandle.h"
+
+#include <algorithm>
 
 void CollisionSystem::checkForLevelCollisionsOnXAxis(Level* level, float timescale) {
     if(level == nullptr) return;
 
-    auto ecs = EntityRegistry::getInstance();
     int tileSize = level->getTileSize();
-    strb::vec2 topLeftTileCoord, bottomRightTileCoord;
+    auto view = _ecs->view<CollisionComponent, PhysicsComponent, TransformComponent>().exclude<DormantComponent>();
+    // Every entity is independent, so batches run in parallel and only projectiles to destroy are collected
+    std::vector<std::vector<Entity>> projectileHits(view.batchCount(entityConstants::PARALLEL_BATCH_SIZE));
     
-    for(auto ent : _entities) {
-        auto& collisionComp = ecs->getComponent<CollisionComponent>(ent);
-        auto& physics = ecs->getComponent<PhysicsComponent>(ent);
-        auto& state = ecs->getComponent<StateComponent>(ent);
+    view.parallelEach(_threadPool, entityConstants::PARALLEL_BATCH_SIZE,
+        [&](size_t batch, Entity ent, CollisionComponent& collisionComp, PhysicsComponent& physics, TransformComponent& transform) {
+        // Entities without a state would otherwise share the blank fallback component across threads
+        auto state = _ecs->tryGetComponent<StateComponent>(ent);
+        // Physics only moves the transform, so the rect catches up with this step's x movement here, where the
+        // components are already at hand
+        if(transform.position.x != transform.lastPosition.x) {
+            collisionComp.collisionRect.x = (int) (transform.position.x + collisionComp.collisionRectOffset.x);
+        }
 
-        topLeftTileCoord.x = (collisionComp.collisionRect.x - 1) / tileSize;
-        topLeftTileCoord.y = collisionComp.collisionRect.y / tileSize;
-        bottomRightTileCoord.x = (collisionComp.collisionRect.x + collisionComp.collisionRect.w + 1) / tileSize;
-        bottomRightTileCoord.y = (collisionComp.collisionRect.y + collisionComp.collisionRect.h - 1) / tileSize;
+        int leftTile = (collisionComp.collisionRect.x - 1) / tileSize;
+        int topTile = collisionComp.collisionRect.y / tileSize;
+        int rightTile = (collisionComp.collisionRect.x + collisionComp.collisionRect.w + 1) / tileSize;
+        int bottomTile = (collisionComp.collisionRect.y + collisionComp.collisionRect.h - 1) / tileSize;
+        // The columns above are only the ones next to where the entity ended up. A fast enough move skips the ones
+        // in between, so sweep the move and resolve against the first wall it ran into if that was further back.
+        strb::real dx = transform.position.x - transform.lastPosition.x;
+        if(dx != 0.f) {
+            TileSweep sweep = level->sweepRect(
+                {transform.lastPosition.x + collisionComp.collisionRectOffset.x, (float) collisionComp.collisionRect.y},
+                {(float) collisionComp.collisionRect.w, (float) collisionComp.collisionRect.h}, {dx, 0.f}, {TileType::SOLID});
+            if(sweep.hit && dx > 0.f && sweep.tileX < rightTile) rightTile = sweep.tileX;
+            else if(sweep.hit && dx < 0.f && sweep.tileX > leftTile) leftTile = sweep.tileX;
+        }
+        bool inLevel = leftTile >= 0 && rightTile < level->getTilemapWidth();
 
-        std::priority_queue<TileCoords> tileCollisions;
         if(physics.velocity.x < 0.f) {
             collisionComp.collidingRight = false;
-            // Entity is moving left - get all tiles to left
-            for(int y = topLeftTileCoord.y; y <= bottomRightTileCoord.y; ++y) {
-                if(topLeftTileCoord.x >= 0 && bottomRightTileCoord.x < level->getTilemapWidth() &&
-                   y >= 0 && y < level->getTilemapHeight()) {
-                    if(level->getTileAt(topLeftTileCoord.x, y).type == TileType::SOLID) {
-                        // Since all the tiles we are looking at share the same x coordinates,
-                        // we can simply just calculate distance on the y axis to find the
-                        // closest tile.
-                        int dist = collisionComp.collisionRect.y - (y * tileSize);
-                        TileCoords t(topLeftTileCoord.x * tileSize, y * tileSize, std::abs(dist));
-                        tileCollisions.emplace(t);
-                    }
-                }
-            }
-
-            // If we have a collision:
-            if(!tileCollisions.empty()) {
-                if(ecs->hasComponent<ProjectileComponent>(ent)) {
-                    ecs->destroyEntity(ent);
+            // Entity is moving left - look for a solid tile in the column to the left. Every tile in it is the same
+            // distance away on the x axis, so any one will do.
+            if(inLevel && level->findTileInColumn(TileType::SOLID, leftTile, topTile, bottomTile) != -1) {
+                if(_ecs->hasComponent<ProjectileComponent>(ent)) {
+                    projectileHits[batch].push_back(ent);
                     return;
                 }
-                auto& transform = ecs->getComponent<TransformComponent>(ent);
                 collisionComp.collidingLeft = true;
-                TileCoords closestTile = tileCollisions.top();
                 // then place entity as close as possible to right of tile
-                transform.position.x = closestTile.x + tileSize - collisionComp.collisionRectOffset.x;
-                collisionComp.collisionRect.x = transform.position.x + collisionComp.collisionRectOffset.x;
-                collisionComp.collisionRect.y = transform.position.y + collisionComp.collisionRectOffset.y;
+                transform.position.x = leftTile * tileSize + tileSize - collisionComp.collisionRectOffset.x;
+                _ecs->markChanged<TransformComponent>(ent);
+                collisionComp.collisionRect.x = (int) (transform.position.x + collisionComp.collisionRectOffset.x);
+                collisionComp.collisionRect.y = (int) (transform.position.y + collisionComp.collisionRectOffset.y);
                 physics.velocity.x = 0.f;
-                if(physics.touchingGround) state.state = EntityState::IDLE;
+                if(physics.touchingGround && state) state->state = EntityState::IDLE;
             }
             else {
                 collisionComp.collidingLeft = false;
@@ -72,36 +77,20 @@ void CollisionSystem::checkForLevelCollisionsOnXAxis(Level* level, float timesca
         }
         else if(physics.velocity.x > 0.f) {
             collisionComp.collidingLeft = false;
-            // Entity is moving right - get all tiles to right
-            for(int y = topLeftTileCoord.y; y <= bottomRightTileCoord.y; ++y) {
-                if(topLeftTileCoord.x >= 0 && bottomRightTileCoord.x < level->getTilemapWidth() &&
-                   y >= 0 && y < level->getTilemapHeight()) {
-                    if(level->getTileAt(bottomRightTileCoord.x, y).type == TileType::SOLID) {
-                        // Since all the tiles we are looking at share the same x coordinates,
-                        // we can simply just calculate distance on the y axis to find the
-                        // closest tile.
-                        int dist = collisionComp.collisionRect.y - (y * tileSize);
-                        TileCoords t(bottomRightTileCoord.x * tileSize, y * tileSize, std::abs(dist));
-                        tileCollisions.emplace(t);
-                    }
-                }
-            }
-
-            // If we have a collision:
-            if(!tileCollisions.empty()) {
-                if(ecs->hasComponent<ProjectileComponent>(ent)) {
-                    ecs->destroyEntity(ent);
+            // Entity is moving right - look for a solid tile in the column to the right
+            if(inLevel && level->findTileInColumn(TileType::SOLID, rightTile, topTile, bottomTile) != -1) {
+                if(_ecs->hasComponent<ProjectileComponent>(ent)) {
+                    projectileHits[batch].push_back(ent);
                     return;
                 }
-                auto& transform = ecs->getComponent<TransformComponent>(ent);
                 collisionComp.collidingRight = true;
-                TileCoords closestTile = tileCollisions.top();
                 // then place entity as close as possible to left of tile
-                transform.position.x = closestTile.x - collisionComp.collisionRect.w - collisionComp.collisionRectOffset.x;
-                collisionComp.collisionRect.x = transform.position.x + collisionComp.collisionRectOffset.x;
-                collisionComp.collisionRect.y = transform.position.y + collisionComp.collisionRectOffset.y;
+                transform.position.x = rightTile * tileSize - collisionComp.collisionRect.w - collisionComp.collisionRectOffset.x;
+                _ecs->markChanged<TransformComponent>(ent);
+                collisionComp.collisionRect.x = (int) (transform.position.x + collisionComp.collisionRectOffset.x);
+                collisionComp.collisionRect.y = (int) (transform.position.y + collisionComp.collisionRectOffset.y);
                 physics.velocity.x = 0.f;
-                if(physics.touchingGround) state.state = EntityState::IDLE;
+                if(physics.touchingGround && state) state->state = EntityState::IDLE;
             }
             else {
                 collisionComp.collidingRight = false;
@@ -112,60 +101,60 @@ void CollisionSystem::checkForLevelCollisionsOnXAxis(Level* level, float timesca
             collisionComp.collidingLeft = false;
             collisionComp.collidingRight = false;
         }
-    }
+    });
+    destroyCollected(projectileHits);
 }
 
 void CollisionSystem::checkForLevelCollisionsOnYAxis(Level* level, float timescale) {
     if(level == nullptr) return;
 
-    auto ecs = EntityRegistry::getInstance();
     int tileSize = level->getTileSize();
-    strb::vec2 topLeftTileCoord, bottomRightTileCoord;
+    auto view = _ecs->view<CollisionComponent, PhysicsComponent, TransformComponent>().exclude<DormantComponent>();
+    // Every entity is independent, so batches run in parallel and only projectiles to destroy are collected
+    std::vector<std::vector<Entity>> projectileHits(view.batchCount(entityConstants::PARALLEL_BATCH_SIZE));
     
-    for(auto ent : _entities) {
-        auto& collisionComp = ecs->getComponent<CollisionComponent>(ent);
-        auto& physics = ecs->getComponent<PhysicsComponent>(ent);
-
-        topLeftTileCoord.x = collisionComp.collisionRect.x / tileSize;
-        topLeftTileCoord.y = collisionComp.collisionRect.y / tileSize;
-        bottomRightTileCoord.x = (collisionComp.collisionRect.x + collisionComp.collisionRect.w - 1) / tileSize;
+    view.parallelEach(_threadPool, entityConstants::PARALLEL_BATCH_SIZE,
+        [&](size_t batch, Entity ent, CollisionComponent& collisionComp, PhysicsComponent& physics, TransformComponent& transform) {
+        // Same for physics' y movement
+        if(transform.position.y != transform.lastPosition.y) {
+            collisionComp.collisionRect.y = (int) (transform.position.y + collisionComp.collisionRectOffset.y);
+        }
+        int leftTile = collisionComp.collisionRect.x / tileSize;
+        int topTile = collisionComp.collisionRect.y / tileSize;
+        int rightTile = (collisionComp.collisionRect.x + collisionComp.collisionRect.w - 1) / tileSize;
         int yDiff = 1;
         if(physics.velocity.y * timescale < 1) yDiff = 0;
-        bottomRightTileCoord.y = (collisionComp.collisionRect.y + collisionComp.collisionRect.h - yDiff) / tileSize;
+        int bottomTile = (collisionComp.collisionRect.y + collisionComp.collisionRect.h - yDiff) / tileSize;
+        // Same as the x axis: resolve against the first floor, ceiling or hazard the move ran into
+        strb::real dy = transform.position.y - transform.lastPosition.y;
+        if(dy != 0.f) {
+            strb::vec2 start = {(float) collisionComp.collisionRect.x, transform.lastPosition.y + collisionComp.collisionRectOffset.y};
+            strb::vec2 size = {(float) collisionComp.collisionRect.w, (float) collisionComp.collisionRect.h};
+            // Hazards only stop things landing on them
+            TileSweep sweep = dy > 0.f ?
+                level->sweepRect(start, size, {0.f, dy}, {TileType::SOLID, TileType::HAZARD}) :
+                level->sweepRect(start, size, {0.f, dy}, {TileType::SOLID});
+            if(sweep.hit && dy > 0.f && sweep.tileY < bottomTile) bottomTile = sweep.tileY;
+            else if(sweep.hit && dy < 0.f && sweep.tileY > topTile) topTile = sweep.tileY;
+        }
+        bool inLevel = topTile >= 0 && bottomTile < level->getTilemapHeight();
 
-        std::priority_queue<TileCoords> tileCollisions;
-        std::priority_queue<TileCoords> hazardCollisions;
         if(physics.velocity.y < 0.f) {
             collisionComp.collidingDown = false;
             physics.touchingGround = false;
-            // Entity is moving up - get all tiles to top
-            for(int x = topLeftTileCoord.x; x <= bottomRightTileCoord.x; ++x) {
-                if(topLeftTileCoord.y >= 0 && bottomRightTileCoord.y < level->getTilemapHeight() &&
-                   x >= 0 && x < level->getTilemapWidth()) {
-                    if(level->getTileAt(x, topLeftTileCoord.y).type == TileType::SOLID) {
-                        // Since all the tiles we are looking at share the same y coordinates,
-                        // we can simply just calculate distance on the x axis to find the
-                        // closest tile.
-                        int dist = collisionComp.collisionRect.x - (x * tileSize);
-                        TileCoords t(x * tileSize, topLeftTileCoord.y * tileSize, std::abs(dist));
-                        tileCollisions.emplace(t);
-                    }
-                }
-            }
-
-            // If we have a collision:
-            if(!tileCollisions.empty()) {
-                if(ecs->hasComponent<ProjectileComponent>(ent)) {
-                    ecs->destroyEntity(ent);
+            // Entity is moving up - look for a solid tile in the row above. Every tile in it is the same distance
+            // away on the y axis, so any one will do.
+            if(inLevel && level->findTileInRow(TileType::SOLID, topTile, leftTile, rightTile) != -1) {
+                if(_ecs->hasComponent<ProjectileComponent>(ent)) {
+                    projectileHits[batch].push_back(ent);
                     return;
                 }
-                auto& transform = ecs->getComponent<TransformComponent>(ent);
                 collisionComp.collidingUp = true;
-                TileCoords closestTile = tileCollisions.top();
                 // then place entity as close as possible to bottom of tile
-                transform.position.y = closestTile.y + tileSize - collisionComp.collisionRectOffset.y;
-                collisionComp.collisionRect.x = transform.position.x + collisionComp.collisionRectOffset.x;
-                collisionComp.collisionRect.y = transform.position.y + collisionComp.collisionRectOffset.y;
+                transform.position.y = topTile * tileSize + tileSize - collisionComp.collisionRectOffset.y;
+                _ecs->markChanged<TransformComponent>(ent);
+                collisionComp.collisionRect.x = (int) (transform.position.x + collisionComp.collisionRectOffset.x);
+                collisionComp.collisionRect.y = (int) (transform.position.y + collisionComp.collisionRectOffset.y);
                 physics.velocity.y = 0.f;
             }
             else {
@@ -174,56 +163,33 @@ void CollisionSystem::checkForLevelCollisionsOnYAxis(Level* level, float timesca
         }
         else if(physics.velocity.y > 0.f) {
             collisionComp.collidingUp = false;
-            // Entity is moving down - get all tiles to bottom
-            for(int x = topLeftTileCoord.x; x <= bottomRightTileCoord.x; ++x) {
-                if(topLeftTileCoord.y >= 0 && bottomRightTileCoord.y < level->getTilemapHeight() &&
-                   x >= 0 && x < level->getTilemapWidth()) {
-                    if(level->getTileAt(x, bottomRightTileCoord.y).type == TileType::SOLID) {
-                        // Since all the tiles we are looking at share the same y coordinates,
-                        // we can simply just calculate distance on the x axis to find the
-                        // closest tile.
-                        int dist = collisionComp.collisionRect.x - (x * tileSize);
-                        TileCoords t(x * tileSize, bottomRightTileCoord.y * tileSize, std::abs(dist));
-                        tileCollisions.emplace(t);
-                    }
-                    else if(level->getTileAt(x, bottomRightTileCoord.y).type == TileType::HAZARD) {
-                        int dist = collisionComp.collisionRect.x - (x * tileSize);
-                        TileCoords t(x * tileSize, bottomRightTileCoord.y * tileSize, std::abs(dist));
-                        hazardCollisions.emplace(t);
-                    }
-                }
-            }
-
-            // If we have a collision:
-            if(!tileCollisions.empty()) {
-                if(ecs->hasComponent<ProjectileComponent>(ent)) {
-                    ecs->destroyEntity(ent);
+            // Entity is moving down - look for a solid tile in the row below, then a hazard
+            if(inLevel && level->findTileInRow(TileType::SOLID, bottomTile, leftTile, rightTile) != -1) {
+                if(_ecs->hasComponent<ProjectileComponent>(ent)) {
+                    projectileHits[batch].push_back(ent);
                     return;
                 }
-                auto& transform = ecs->getComponent<TransformComponent>(ent);
                 collisionComp.collidingDown = true;
                 physics.touchingGround = true;
-                TileCoords closestTile = tileCollisions.top();
                 // then place entity as close as possible to top of tile
-                transform.position.y = closestTile.y - collisionComp.collisionRect.h - collisionComp.collisionRectOffset.y;
-                collisionComp.collisionRect.x = transform.position.x + collisionComp.collisionRectOffset.x;
-                collisionComp.collisionRect.y = transform.position.y + collisionComp.collisionRectOffset.y;
+                transform.position.y = bottomTile * tileSize - collisionComp.collisionRect.h - collisionComp.collisionRectOffset.y;
+                _ecs->markChanged<TransformComponent>(ent);
+                collisionComp.collisionRect.x = (int) (transform.position.x + collisionComp.collisionRectOffset.x);
+                collisionComp.collisionRect.y = (int) (transform.position.y + collisionComp.collisionRectOffset.y);
                 physics.velocity.y = 0.f;
             }
-            else if(!hazardCollisions.empty()) {
-                if(ecs->hasComponent<BootsComponent>(ent) && physics.velocity.y * timescale < 1.f) {
-                    auto& transform = ecs->getComponent<TransformComponent>(ent);
+            else if(inLevel && level->findTileInRow(TileType::HAZARD, bottomTile, leftTile, rightTile) != -1) {
+                if(_ecs->hasComponent<BootsComponent>(ent) && physics.velocity.y * timescale < 1.f) {
                     collisionComp.collidingDown = true;
                     physics.touchingGround = true;
-                    TileCoords closestTile = hazardCollisions.top();
-                    transform.position.y = closestTile.y - collisionComp.collisionRect.h - collisionComp.collisionRectOffset.y;
-                    collisionComp.collisionRect.x = transform.position.x + collisionComp.collisionRectOffset.x;
-                    collisionComp.collisionRect.y = transform.position.y + collisionComp.collisionRectOffset.y;
+                    transform.position.y = bottomTile * tileSize - collisionComp.collisionRect.h - collisionComp.collisionRectOffset.y;
+                    _ecs->markChanged<TransformComponent>(ent);
+                    collisionComp.collisionRect.x = (int) (transform.position.x + collisionComp.collisionRectOffset.x);
+                    collisionComp.collisionRect.y = (int) (transform.position.y + collisionComp.collisionRectOffset.y);
                     physics.velocity.y = 0.f;
                 }
                 else {
-                    auto& health = ecs->getComponent<HealthComponent>(ent);
-                    health.hitpoints = 0;
+                    if(auto health = _ecs->tryGetComponent<HealthComponent>(ent)) health->hitpoints = 0;
                     physics.velocity.x = 0;
                     physics.velocity.y = 0;
                 }
@@ -233,119 +199,153 @@ void CollisionSystem::checkForLevelCollisionsOnYAxis(Level* level, float timesca
                 physics.touchingGround = false;
             }
         }
-    }
+    });
+    destroyCollected(projectileHits);
 }
 
-bool CollisionSystem::checkForPlayerAndItemCollisions(Entity player, float timescale, std::string& itemMessage, PickupType& pickupType) {
-    auto ecs = EntityRegistry::getInstance();
-    auto playerCollision = ecs->getComponent<CollisionComponent>(player);
-    for(auto item : ecs->getAllOf<PickupComponent>()) {
-        auto& itemCollision = ecs->getComponent<CollisionComponent>(item);
-        auto& itemTransform = ecs->getComponent<TransformComponent>(item);
-        itemCollision.collisionRect.x = itemTransform.position.x + itemCollision.collisionRectOffset.x;
-        itemCollision.collisionRect.y = itemTransform.position.y + itemCollision.collisionRectOffset.y;
-        if(SDL_HasIntersection(&playerCollision.collisionRect, &itemCollision.collisionRect)) {
-            auto pickup = ecs->getComponent<PickupComponent>(item);
-            if(pickup.onPickupScript) pickup.onPickupScript->update(item, timescale, _audioPlayer);
-            if(pickup.onPickupMessage.size() > 0) itemMessage = pickup.onPickupMessage;
-            pickupType = pickup.pickupType;
-            ecs->destroyEntity(item);
-            return true;
+void CollisionSystem::checkForPlayerAndItemCollisions(Entity player, float timescale) {
+    auto playerCollision = _ecs->getComponent<CollisionComponent>(player);
+    std::vector<Entity> candidates;
+    _broadphase.query(playerCollision.collisionRect, candidates);
+    for(auto item : candidates) {
+        auto pickup = _ecs->tryGetComponent<PickupComponent>(item);
+        auto itemCollision = _ecs->tryGetComponent<CollisionComponent>(item);
+        if(pickup == nullptr || itemCollision == nullptr) continue;
+        if(SDL_HasIntersection(&playerCollision.collisionRect, &itemCollision->collisionRect)) {
+            if(pickup->onPickupScript) pickup->onPickupScript->update(_ecs, item, timescale, _audioPlayer);
+            _ecs->getEventBus().publish(PickupEvent{item, pickup->pickupType, pickup->onPickupMessage});
+            _ecs->getCommandBuffer().destroyEntity(item);
         }
     }
-    return false;
 }
 
-bool CollisionSystem::checkForPlayerAndCheckpointCollisions(Entity player, float timescale, Entity& checkpointResult) {
-    auto ecs = EntityRegistry::getInstance();
-    auto playerCollision = ecs->getComponent<CollisionComponent>(player);
-    for(auto checkpoint : ecs->getAllOf<CheckpointComponent>()) {
-        auto& checkpointComp = ecs->getComponent<CheckpointComponent>(checkpoint);
-        auto checkpointCollision = ecs->getComponent<CollisionComponent>(checkpoint);
-        auto& checkpointTransform = ecs->getComponent<TransformComponent>(checkpoint);
-        checkpointCollision.collisionRect.x = checkpointTransform.position.x + checkpointCollision.collisionRectOffset.x;
-        checkpointCollision.collisionRect.y = checkpointTransform.position.y + checkpointCollision.collisionRectOffset.y;
-        if(SDL_HasIntersection(&playerCollision.collisionRect, &checkpointCollision.collisionRect)) {
-            checkpointResult = checkpoint;
-            return true;
+void CollisionSystem::checkForPlayerAndCheckpointCollisions(Entity player, float timescale) {
+    // Every checkpoint's touching flag has to be cleared when the player leaves it, and there are only a few, so
+    // this walks all of them rather than asking the broadphase
+    auto playerCollision = _ecs->getComponent<CollisionComponent>(player);
+    for(auto [checkpoint, checkpointComp, checkpointCollision] : _ecs->view<CheckpointComponent, CollisionComponent>()) {
+        bool touching = SDL_HasIntersection(&playerCollision.collisionRect, &checkpointCollision.collisionRect);
+        if(touching && !checkpointComp.isTouchingPlayer) {
+            _ecs->getEventBus().publish(CheckpointActivatedEvent{checkpoint});
         }
+        checkpointComp.isTouchingPlayer = touching;
     }
-    return false;
 }
 
 void CollisionSystem::checkForProjectileAndEnemyCollisions(float timescale) {
-    auto ecs = EntityRegistry::getInstance();
-    // bad n^2 loop here but such few entities it doesn't matter
-    for(auto proj : ecs->getAllOf<ProjectileComponent>()) {
-        auto& projCollision = ecs->getComponent<CollisionComponent>(proj);
-        auto& projTransform = ecs->getComponent<TransformComponent>(proj);
-        projCollision.collisionRect.x = projTransform.position.x + projCollision.collisionRectOffset.x;
-        projCollision.collisionRect.y = projTransform.position.y + projCollision.collisionRectOffset.y;
-        for(auto ent : ecs->getAllOf<HealthComponent>()) {
-            if(ecs->hasComponent<PlayerComponent>(ent)) continue;
-            auto entCollision = ecs->getComponent<CollisionComponent>(ent);
-            auto& entTransform = ecs->getComponent<TransformComponent>(ent);
-            entCollision.collisionRect.x = entTransform.position.x + entCollision.collisionRectOffset.x;
-            entCollision.collisionRect.y = entTransform.position.y + entCollision.collisionRectOffset.y;
-            if(SDL_HasIntersection(&projCollision.collisionRect, &entCollision.collisionRect)) {
-                auto& physics = ecs->getComponent<PhysicsComponent>(ent);
-                physics.velocity.x = 0;
-                physics.velocity.y = 0;
-                auto& health = ecs->getComponent<HealthComponent>(ent);
-                auto& projectileComp = ecs->getComponent<ProjectileComponent>(ent);
-                health.hitpoints -= projectileComp.damage;
-                ecs->destroyEntity(proj);
-            }
-        }
+    // One pass over every pair of entities sharing a broadphase cell finds what each projectile overlaps
+    _broadphase.queryPairs(_pairs);
+    _projectileHits.clear();
+    for(auto [a, b] : _pairs) {
+        // Overlap first, since most pairs sharing a cell don't, and it rules out both ways round at once
+        auto collisionA = _ecs->tryGetComponent<CollisionComponent>(a);
+        auto collisionB = _ecs->tryGetComponent<CollisionComponent>(b);
+        if(collisionA == nullptr || collisionB == nullptr) continue;
+        if(!SDL_HasIntersection(&collisionA->collisionRect, &collisionB->collisionRect)) continue;
+        collectProjectileHit(a, b);
+        collectProjectileHit(b, a);
+    }
+    if(_projectileHits.empty()) return;
+    // Sorted so that each projectile's first hit is the target with the lowest slot
+    std::sort(_projectileHits.begin(), _projectileHits.end(), [](const std::pair<Entity, Entity>& a, const std::pair<Entity, Entity>& b) {
+        std::uint32_t projA = entityHandle::getIndex(a.first);
+        std::uint32_t projB = entityHandle::getIndex(b.first);
+        if(projA != projB) return projA < projB;
+        return entityHandle::getIndex(a.second) < entityHandle::getIndex(b.second);
+    });
+
+    // Hits are applied in view order, so projectiles are queued to be destroyed in the same order as a loop over them.
+    // Projectiles that hit are only destroyed at the next flush, so the view stays intact while looping.
+    for(auto [proj, projectileComp, projCollision, projTransform] : _ecs->view<ProjectileComponent, CollisionComponent, TransformComponent>()) {
+        auto hit = std::lower_bound(_projectileHits.begin(), _projectileHits.end(), entityHandle::getIndex(proj),
+            [](const std::pair<Entity, Entity>& projectileHit, std::uint32_t slot) {
+            return entityHandle::getIndex(projectileHit.first) < slot;
+        });
+        if(hit == _projectileHits.end() || hit->first != proj) continue;
+        auto& physics = _ecs->getComponent<PhysicsComponent>(hit->second);
+        physics.velocity.x = 0;
+        physics.velocity.y = 0;
+        _ecs->getComponent<HealthComponent>(hit->second).hitpoints -= projectileComp.damage;
+        _ecs->getCommandBuffer().destroyEntity(proj);
     }
 }
 
 void CollisionSystem::checkForPlayerAndEnemyCollisions(Entity player, float timescale) {
-    auto ecs = EntityRegistry::getInstance();
-    auto playerCollision = ecs->getComponent<CollisionComponent>(player);
-    for(auto ent : ecs->getAllOf<EnemyComponent>()) {
-        auto entCollision = ecs->getComponent<CollisionComponent>(ent);
-        auto& entTransform = ecs->getComponent<TransformComponent>(ent);
-        entCollision.collisionRect.x = entTransform.position.x + entCollision.collisionRectOffset.x;
-        entCollision.collisionRect.y = entTransform.position.y + entCollision.collisionRectOffset.y;
-        if(SDL_HasIntersection(&playerCollision.collisionRect, &entCollision.collisionRect)) {
-            auto& physics = ecs->getComponent<PhysicsComponent>(ent);
-            physics.velocity.x = 0;
-            physics.velocity.y = 0;
-            auto& health = ecs->getComponent<HealthComponent>(player);
+    auto playerCollision = _ecs->getComponent<CollisionComponent>(player);
+    std::vector<Entity> candidates;
+    _broadphase.query(playerCollision.collisionRect, candidates);
+    for(auto ent : candidates) {
+        if(!_ecs->hasComponent<EnemyComponent>(ent) || !_ecs->hasComponent<TransformComponent>(ent)) continue;
+        auto entCollision = _ecs->tryGetComponent<CollisionComponent>(ent);
+        auto physics = _ecs->tryGetComponent<PhysicsComponent>(ent);
+        if(entCollision == nullptr || physics == nullptr) continue;
+        if(SDL_HasIntersection(&playerCollision.collisionRect, &entCollision->collisionRect)) {
+            physics->velocity.x = 0;
+            physics->velocity.y = 0;
+            auto& health = _ecs->getComponent<HealthComponent>(player);
             health.hitpoints -= 1;
             return;
         }
     }
 }
 
-bool CollisionSystem::checkForPlayerAndGoalCollisions(Entity player, float timescale, Entity& goalResult) {
-    auto ecs = EntityRegistry::getInstance();
-    auto playerCollision = ecs->getComponent<CollisionComponent>(player);
-    for(auto goal : ecs->getAllOf<GoalComponent>()) {
-        auto& goalComp = ecs->getComponent<GoalComponent>(goal);
-        if(goalComp.activated) continue;
-        auto goalCollision = ecs->getComponent<CollisionComponent>(goal);
-        auto goalTransform = ecs->getComponent<TransformComponent>(goal);
-        goalCollision.collisionRect.x = goalTransform.position.x + goalCollision.collisionRectOffset.x;
-        goalCollision.collisionRect.y = goalTransform.position.y + goalCollision.collisionRectOffset.y;
-        if(SDL_HasIntersection(&playerCollision.collisionRect, &goalCollision.collisionRect)) {
-            goalResult = goal;
-            goalComp.onActivatedScript->update(goalResult, timescale, _audioPlayer);
-            return true;
+void CollisionSystem::checkForPlayerAndGoalCollisions(Entity player, float timescale) {
+    auto playerCollision = _ecs->getComponent<CollisionComponent>(player);
+    std::vector<Entity> candidates;
+    _broadphase.query(playerCollision.collisionRect, candidates);
+    for(auto goal : candidates) {
+        auto goalComp = _ecs->tryGetComponent<GoalComponent>(goal);
+        auto goalCollision = _ecs->tryGetComponent<CollisionComponent>(goal);
+        if(goalComp == nullptr || goalCollision == nullptr || goalComp->activated) continue;
+        if(SDL_HasIntersection(&playerCollision.collisionRect, &goalCollision->collisionRect)) {
+            goalComp->onActivatedScript->update(_ecs, goal, timescale, _audioPlayer);
+            _ecs->getEventBus().publish(CollisionBeginEvent{player, goal});
         }
     }
-    return false;
 }
 
+void CollisionSystem::updateCollisionRects() {
+    std::uint32_t since = _lastRectSync;
+    _lastRectSync = _ecs->advanceChangeTick();
+    for(auto [ent, collision, transform] : _ecs->view<CollisionComponent, TransformComponent>().changed<CollisionComponent, TransformComponent>(since)) {
+        collision.collisionRect.x = (int) (transform.position.x + collision.collisionRectOffset.x);
+        collision.collisionRect.y = (int) (transform.position.y + collision.collisionRectOffset.y);
+        _broadphase.update(ent, collision.collisionRect);
+    }
+    // Destroyed entities never show up as changed, so they are dropped once the broadphase holds more entities than
+    // have a collision rect. Until then the checks skip them, since their components are gone.
+    if(_broadphase.size() > _ecs->getAllOf<CollisionComponent>().size()) {
+        _broadphase.removeIf([this](Entity ent) {
+            return !_ecs->hasComponent<CollisionComponent>(ent) || !_ecs->hasComponent<TransformComponent>(ent);
+        });
+    }
+}
+
+void CollisionSystem::setBroadphaseCellSize(int cellSize) {
+    _broadphase.setCellSize(cellSize);
+    // Everything counts as changed since tick 0, so the next update puts every entity back
+    _lastRectSync = 0;
+}
+
+void CollisionSystem::collectProjectileHit(Entity proj, Entity ent) {
+    if(!_ecs->hasComponent<ProjectileComponent>(proj) || !_ecs->hasComponent<HealthComponent>(ent)) return;
+    if(!_ecs->hasComponent<TransformComponent>(proj) || !_ecs->hasComponent<TransformComponent>(ent)) return;
+    if(_ecs->hasComponent<PlayerComponent>(ent) || !_ecs->hasComponent<PhysicsComponent>(ent)) return;
+    _projectileHits.push_back({proj, ent});
+}
+
+void CollisionSystem::destroyCollected(const std::vector<std::vector<Entity>>& batches) {
+    auto& commands = _ecs->getCommandBuffer();
+    // Last batch first, so entities are queued in the same order a serial back to front loop would use
+    for(size_t batch = batches.size(); batch-- > 0;) {
+        for(auto ent : batches[batch]) {
+            commands.destroyEntity(ent);
+        }
+    }
+}
 
 void CollisionSystem::checkIfOnEdge(Level* level) {
-    auto ecs = EntityRegistry::getInstance();
-    for(auto ent : _entities) {
-        if(!ecs->hasComponent<EdgeCheckComponent>(ent)) continue;
-        auto& physics = ecs->getComponent<PhysicsComponent>(ent);
-        auto& edgeCheck = ecs->getComponent<EdgeCheckComponent>(ent);
-        auto& collision = ecs->getComponent<CollisionComponent>(ent);
+    for(auto [ent, edgeCheck, physics, collision] : _ecs->view<EdgeCheckComponent, PhysicsComponent, CollisionComponent>().exclude<DormantComponent>()) {
         if(physics.offGroundCount > 4) {
             edgeCheck.onLeftEdge = false;
             edgeCheck.onRightEdge = false;
@@ -360,8 +360,7 @@ void CollisionSystem::checkIfOnEdge(Level* level) {
             edgeCheck.onLeftEdge = false;
         }
         else {
-            edgeCheck.onLeftEdge = level->getTileAt(bottomLeftTileCoord.x, bottomLeftTileCoord.y)
-                .type != TileType::SOLID;
+            edgeCheck.onLeftEdge = !level->isTileType(bottomLeftTileCoord.x, bottomLeftTileCoord.y, TileType::SOLID);
         }
         SDL_Point bottomRightTileCoord;
         bottomRightTileCoord.x = (collision.collisionRect.x + collision.collisionRect.w) / tileSize;
@@ -371,8 +370,7 @@ void CollisionSystem::checkIfOnEdge(Level* level) {
             edgeCheck.onRightEdge = false;
         }
         else {
-            edgeCheck.onRightEdge = level->getTileAt(bottomRightTileCoord.x, bottomRightTileCoord.y)
-                .type != TileType::SOLID;
+            edgeCheck.onRightEdge = !level->isTileType(bottomRightTileCoord.x, bottomRightTileCoord.y, TileType::SOLID);
         }
     }
 }
\ No newline at end of file
@@ -3,22 +3,11 @@
 
 #include "System.h"
 #include "Level.h"
-#include "PickupComponent.h"
+#include "SpatialHash.h"
 
-namespace {
-    struct TileCoords {
-        int x;
-        int y;
-        int dist;
-
-        TileCoords(int x, int y, int dist) : x(x), y(y), dist(dist) {}
-
-        bool operator<(const TileCoords& rhs) const
-        {
-            return dist < rhs.dist;
-        }
-    };
-}
+#include <cstdint>
+#include <utility>
+#include <vector>
 
 class CollisionSystem : public System {
 public:
@@ -27,14 +16,60 @@ public:
 
     void checkForLevelCollisionsOnXAxis(Level* level, float timescale);
     void checkForLevelCollisionsOnYAxis(Level* level, float timescale);
-    bool checkForPlayerAndItemCollisions(Entity player, float timescale, std::string& itemMessage, PickupType& pickupType);
-    bool checkForPlayerAndCheckpointCollisions(Entity player, float timescale, Entity& checkpointResult);
+    /**
+     * @brief Runs the pickup script of every pickup the player touches, publishes a PickupEvent for each and queues
+     * them to be destroyed.
+     */
+    void checkForPlayerAndItemCollisions(Entity player, float timescale);
+    /**
+     * @brief Publishes a CheckpointActivatedEvent for every checkpoint the player started touching since the last
+     * check.
+     */
+    void checkForPlayerAndCheckpointCollisions(Entity player, float timescale);
+    /**
+     * @brief Each projectile damages the first entity with health it overlaps, other than the player, and is queued
+     * to be destroyed. When several are hit at once, the one with the lowest entity slot takes the damage.
+     */
     void checkForProjectileAndEnemyCollisions(float timescale);
     void checkForPlayerAndEnemyCollisions(Entity player, float timescale);
-    bool checkForPlayerAndGoalCollisions(Entity player, float timescale, Entity& goalResult);
+    /**
+     * @brief Runs the activation script of every goal the player reaches and publishes a CollisionBeginEvent for it.
+     * Goals that were already activated are skipped.
+     */
+    void checkForPlayerAndGoalCollisions(Entity player, float timescale);
     void checkIfOnEdge(Level* level);
+    /**
+     * @brief Moves the collision rect of every entity whose transform changed since the last call (or that is new)
+     * to match its position, and updates the broadphase to match. The player/entity checks above rely on this having
+     * run after the last movement.
+     */
+    void updateCollisionRects();
+
+    /**
+     * @brief Sets the size of a broadphase cell, usually the level's tile size. Every entity is put back into the
+     * broadphase by the next updateCollisionRects().
+     */
+    void setBroadphaseCellSize(int cellSize);
 
 private:
+    /**
+     * @brief Records a hit if proj is a projectile and ent is something it can damage. The caller has already checked
+     * that they overlap.
+     */
+    void collectProjectileHit(Entity proj, Entity ent);
+    void destroyCollected(const std::vector<std::vector<Entity>>& batches);
+
+    // Entities with a collision rect and a transform, by the cells their rect touches. Only changed alongside the
+    // collision rects, so tasks that read CollisionComponent may query it at the same time.
+    SpatialHash _broadphase;
+
+    // Reused by checkForProjectileAndEnemyCollisions(), so it does not allocate every frame. Hits are (projectile,
+    // target).
+    std::vector<std::pair<Entity, Entity>> _pairs;
+    std::vector<std::pair<Entity, Entity>> _projectileHits;
+
+    // Change tick returned when the collision rects were last brought up to date
+    std::uint32_t _lastRectSync = 0;
 
 };
 
@@ -1,19 +1,15 @@
 #include "DeathSystem.h"
-#include "EntityRegistry.h"
+#include "EntityComponentSystem.h"
 #include "HealthComponent.h"
 #include "PlayerComponent.h"
+#include "GameEvents.h"
 
 void DeathSystem::update(float timescale) {
-    auto ecs = EntityRegistry::getInstance();
-    for(auto ent : _entities) {
-        auto health = ecs->getComponent<HealthComponent>(ent);
+    for(auto [ent, health] : _ecs->view<HealthComponent>()) {
         if(health.hitpoints <= 0) {
-            if(ecs->hasComponent<PlayerComponent>(ent)) {
-                
-            }
-            else {
-                ecs->destroyEntity(ent);
-            }
+            _ecs->getEventBus().publish(DeathEvent{ent});
+            // The player is respawned by the game rather than destroyed
+            if(!_ecs->hasComponent<PlayerComponent>(ent)) _ecs->getCommandBuffer().destroyEntity(ent);
         }
     }
 }
\ No newline at end of file
@@ -1,5 +1,5 @@
 #include "InputSystem.h"
-#include "EntityRegistry.h"
+#include "EntityComponentSystem.h"
 #include "InputComponent.h"
 #include "PhysicsComponent.h"
 #include "StateComponent.h"
@@ -19,19 +19,20 @@ void InputSystem::init(Keyboard* keyboard, Controller* controller, Settings* set
 }
 
 void InputSystem::update() {
-    auto ecs = EntityRegistry::getInstance();
-    for(auto ent : _entities) {
-        auto& inputComponent = ecs->getComponent<InputComponent>(ent);
+    _entities.sort();
+    for(size_t i = _entities.size(); i-- > 0;) {
+        Entity ent = _entities[i];
+        auto& inputComponent = _ecs->getComponent<InputComponent>(ent);
         auto allowedInputs = inputComponent.allowedInputs;
 
-        auto& physics = ecs->getComponent<PhysicsComponent>(ent);
-        auto& state = ecs->getComponent<StateComponent>(ent);
-        auto& dir = ecs->getComponent<DirectionComponent>(ent);
+        auto& physics = _ecs->getComponent<PhysicsComponent>(ent);
+        auto& state = _ecs->getComponent<StateComponent>(ent);
+        auto& dir = _ecs->getComponent<DirectionComponent>(ent);
 
         // X inputs
         if(inputDown(InputEvent::LEFT) &&
            std::find(allowedInputs.begin(), allowedInputs.end(), InputEvent::LEFT) != allowedInputs.end()) {
-            float acceleration = (physics.touchingGround) ? physics.acceleration.x : physics.airAcceleration.x;
+            strb::real acceleration = (physics.touchingGround) ? physics.acceleration.x : physics.airAcceleration.x;
             // check if acceleration is just past max velocity (this allows us to cruise above max speed in certain instances)
             if(physics.velocity.x - acceleration < physics.maxVelocity.x * -1 &&
                physics.velocity.x - acceleration > physics.maxVelocity.x * -1 - acceleration) {
@@ -43,7 +44,7 @@ void InputSystem::update() {
         }
         else if(inputDown(InputEvent::RIGHT) &&
            std::find(allowedInputs.begin(), allowedInputs.end(), InputEvent::RIGHT) != allowedInputs.end()) {
-            float acceleration = (physics.touchingGround) ? physics.acceleration.x : physics.airAcceleration.x;
+            strb::real acceleration = (physics.touchingGround) ? physics.acceleration.x : physics.airAcceleration.x;
             // check if acceleration is just past max velocity (this allows us to cruise above max speed in certain instances)
             if(physics.velocity.x + acceleration > physics.maxVelocity.x &&
                physics.velocity.x + acceleration < physics.maxVelocity.x + acceleration) {
@@ -64,10 +65,10 @@ void InputSystem::update() {
                 physics.offGroundCount = 5;
                 _audioPlayer->playAudio(ent, AudioSound::JUMP, 1.f);
             }
-            else if(ecs->hasComponent<WalljumpComponent>(ent)) {
-                auto collision = ecs->getComponent<CollisionComponent>(ent);
+            else if(_ecs->hasComponent<WalljumpComponent>(ent)) {
+                auto& collision = _ecs->getComponent<CollisionComponent>(ent);
                 if(collision.collidingLeft || collision.collidingRight) {
-                    float coefficient = (collision.collidingLeft) ? 1.f : -1.f;
+                    strb::real coefficient = (collision.collidingLeft) ? 1.f : -1.f;
                     physics.velocity.x += 200.f * coefficient;
                     physics.velocity.y = physics.jumpPower * -1.f;
                     state.state = EntityState::JUMPING;
@@ -83,16 +84,15 @@ void InputSystem::update() {
         // Other inputs
         if(inputPressed(InputEvent::SHOOT) &&
            std::find(allowedInputs.begin(), allowedInputs.end(), InputEvent::JUMP) != allowedInputs.end()) {
-            if(ecs->hasComponent<WeaponComponent>(ent)) {
-                auto& weapon = ecs->getComponent<WeaponComponent>(ent);
-                if(weapon.timeSinceLastShot >= weapon.shotCooldown) {
-                    auto renderComp = ecs->getComponent<RenderComponent>(ent);
+            if(auto weapon = _ecs->tryGetComponent<WeaponComponent>(ent)) {
+                if(weapon->timeSinceLastShot >= weapon->shotCooldown) {
+                    auto& renderComp = _ecs->getComponent<RenderComponent>(ent);
                     strb::vec2 spawnPos = {
                         (float) renderComp.renderQuad.x + renderComp.renderQuadOffset.x + renderComp.renderQuad.w / 2,
                         (float) renderComp.renderQuad.y + renderComp.renderQuadOffset.y + renderComp.renderQuad.h / 2
                     };
-                    prefab::Projectile::create(spawnPos, dir.direction);
-                    weapon.timeSinceLastShot = 0;
+                    prefab::Projectile::create(_ecs, spawnPos, dir.direction);
+                    weapon->timeSinceLastShot = 0;
                     _audioPlayer->playAudio(ent, AudioSound::SHOOT, 1.f);
                 }
             }
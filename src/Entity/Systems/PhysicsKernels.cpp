@@ -0,0 +1,157 @@
+#include "PhysicsKernels.h"
+
+// The vector kernels are float only and need GCC or Clang to build them for a CPU the rest of the game does not
+// assume. Fixed-point builds and other compilers get the scalar kernels alone.
+#if !defined(FIXED_POINT_SIMULATION) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PHYSICS_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+    // Scalar kernels. These are the reference the vector kernels have to match bit for bit, and they also finish off
+    // the bodies left over after the last full vector.
+
+    void integrateXScalar(strb::real* velocity, strb::real* position, const strb::real* friction, size_t count,
+        strb::real timescale) {
+        for(size_t i = 0; i < count; ++i) {
+            strb::real v = velocity[i];
+            if(v == 0.f) continue;
+            position[i] += v * timescale;
+            if(v > 0.f) {
+                velocity[i] = (v > friction[i]) ? v - friction[i] : 0.f;
+            }
+            else {
+                velocity[i] = (strb::abs(v) > friction[i]) ? v + friction[i] : 0.f;
+            }
+        }
+    }
+
+    void integrateYScalar(strb::real* velocity, strb::real* position, const strb::real* gravity,
+        const strb::real* maxVelocity, size_t count, strb::real timescale) {
+        for(size_t i = 0; i < count; ++i) {
+            strb::real v = velocity[i] + gravity[i];
+            if(v > maxVelocity[i]) v = maxVelocity[i];
+            velocity[i] = v;
+            position[i] += v * timescale;
+        }
+    }
+
+#ifdef PHYSICS_KERNELS_X86
+    // Picks a where the mask is set and b elsewhere
+    __attribute__((target("sse2")))
+    inline __m128 select(__m128 mask, __m128 a, __m128 b) {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    __attribute__((target("avx2")))
+    inline __m256 select(__m256 mask, __m256 a, __m256 b) {
+        return _mm256_blendv_ps(b, a, mask);
+    }
+
+    // In the vector kernels below, friction for a body that is not moving is worked out and then thrown away, and a
+    // speed that friction stops is masked to +0, which is what the scalar kernel writes.
+
+    __attribute__((target("sse2")))
+    void integrateXSse2(strb::real* velocity, strb::real* position, const strb::real* friction, size_t count,
+        strb::real timescale) {
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 signBit = _mm_set1_ps(-0.f);
+        const __m128 step = _mm_set1_ps(timescale);
+        size_t i = 0;
+        for(; i + 4 <= count; i += 4) {
+            __m128 v = _mm_loadu_ps(velocity + i);
+            __m128 p = _mm_loadu_ps(position + i);
+            __m128 f = _mm_loadu_ps(friction + i);
+            __m128 moving = _mm_cmpneq_ps(v, zero);
+            p = select(moving, _mm_add_ps(p, _mm_mul_ps(v, step)), p);
+            __m128 slowed = select(_mm_cmpgt_ps(v, zero), _mm_sub_ps(v, f), _mm_add_ps(v, f));
+            slowed = _mm_and_ps(_mm_cmpgt_ps(_mm_andnot_ps(signBit, v), f), slowed);
+            v = select(moving, slowed, v);
+            _mm_storeu_ps(velocity + i, v);
+            _mm_storeu_ps(position + i, p);
+        }
+        integrateXScalar(velocity + i, position + i, friction + i, count - i, timescale);
+    }
+
+    __attribute__((target("sse2")))
+    void integrateYSse2(strb::real* velocity, strb::real* position, const strb::real* gravity,
+        const strb::real* maxVelocity, size_t count, strb::real timescale) {
+        const __m128 step = _mm_set1_ps(timescale);
+        size_t i = 0;
+        for(; i + 4 <= count; i += 4) {
+            __m128 v = _mm_add_ps(_mm_loadu_ps(velocity + i), _mm_loadu_ps(gravity + i));
+            // min(a, b) is a < b ? a : b, which is the scalar kernel's cap with the same NaN handling
+            v = _mm_min_ps(_mm_loadu_ps(maxVelocity + i), v);
+            __m128 p = _mm_add_ps(_mm_loadu_ps(position + i), _mm_mul_ps(v, step));
+            _mm_storeu_ps(velocity + i, v);
+            _mm_storeu_ps(position + i, p);
+        }
+        integrateYScalar(velocity + i, position + i, gravity + i, maxVelocity + i, count - i, timescale);
+    }
+
+    __attribute__((target("avx2")))
+    void integrateXAvx2(strb::real* velocity, strb::real* position, const strb::real* friction, size_t count,
+        strb::real timescale) {
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 signBit = _mm256_set1_ps(-0.f);
+        const __m256 step = _mm256_set1_ps(timescale);
+        size_t i = 0;
+        for(; i + 8 <= count; i += 8) {
+            __m256 v = _mm256_loadu_ps(velocity + i);
+            __m256 p = _mm256_loadu_ps(position + i);
+            __m256 f = _mm256_loadu_ps(friction + i);
+            __m256 moving = _mm256_cmp_ps(v, zero, _CMP_NEQ_UQ);
+            p = select(moving, _mm256_add_ps(p, _mm256_mul_ps(v, step)), p);
+            __m256 slowed = select(_mm256_cmp_ps(v, zero, _CMP_GT_OQ), _mm256_sub_ps(v, f), _mm256_add_ps(v, f));
+            slowed = _mm256_and_ps(_mm256_cmp_ps(_mm256_andnot_ps(signBit, v), f, _CMP_GT_OQ), slowed);
+            v = select(moving, slowed, v);
+            _mm256_storeu_ps(velocity + i, v);
+            _mm256_storeu_ps(position + i, p);
+        }
+        integrateXScalar(velocity + i, position + i, friction + i, count - i, timescale);
+    }
+
+    __attribute__((target("avx2")))
+    void integrateYAvx2(strb::real* velocity, strb::real* position, const strb::real* gravity,
+        const strb::real* maxVelocity, size_t count, strb::real timescale) {
+        const __m256 step = _mm256_set1_ps(timescale);
+        size_t i = 0;
+        for(; i + 8 <= count; i += 8) {
+            __m256 v = _mm256_add_ps(_mm256_loadu_ps(velocity + i), _mm256_loadu_ps(gravity + i));
+            v = _mm256_min_ps(_mm256_loadu_ps(maxVelocity + i), v);
+            __m256 p = _mm256_add_ps(_mm256_loadu_ps(position + i), _mm256_mul_ps(v, step));
+            _mm256_storeu_ps(velocity + i, v);
+            _mm256_storeu_ps(position + i, p);
+        }
+        integrateYScalar(velocity + i, position + i, gravity + i, maxVelocity + i, count - i, timescale);
+    }
+#endif
+}
+
+namespace physicsKernels {
+    const KernelSet& scalar() {
+        static const KernelSet kernels = {"scalar", integrateXScalar, integrateYScalar};
+        return kernels;
+    }
+
+    const KernelSet* sse2() {
+#ifdef PHYSICS_KERNELS_X86
+        static const KernelSet kernels = {"sse2", integrateXSse2, integrateYSse2};
+        if(__builtin_cpu_supports("sse2")) return &kernels;
+#endif
+        return nullptr;
+    }
+
+    const KernelSet* avx2() {
+#ifdef PHYSICS_KERNELS_X86
+        static const KernelSet kernels = {"avx2", integrateXAvx2, integrateYAvx2};
+        if(__builtin_cpu_supports("avx2")) return &kernels;
+#endif
+        return nullptr;
+    }
+
+    const KernelSet& best() {
+        static const KernelSet& kernels = avx2() ? *avx2() : sse2() ? *sse2() : scalar();
+        return kernels;
+    }
+}
\ No newline at end of file
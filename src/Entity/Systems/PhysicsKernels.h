@@ -0,0 +1,58 @@
+#ifndef PHYSICS_KERNELS_H
+#define PHYSICS_KERNELS_H
+
+#include "real.h"
+
+#include <cstddef>
+
+/**
+ * @brief Batch integration used by PhysicsSystem. Bodies are gathered into one array per value (velocity, position,
+ * friction and so on), and a kernel works through a whole array at once.
+ *
+ * The scalar kernels are the reference. The SSE2 and AVX2 kernels do the same float operations in the same order, so
+ * they give bit-identical results, and best() picks the widest one the CPU supports the first time it is called. The
+ * one exception is which NaN comes out of maths on a NaN, which the compiler is free to change in the scalar kernels.
+ * Fixed-point builds only have the scalar kernels.
+ */
+namespace physicsKernels {
+    /**
+     * @brief Moves bodies along x by velocity * timescale, then takes friction off the speed, stopping at zero.
+     * Bodies with no x velocity are left alone.
+     *
+     * @param friction Per body, the ground or air friction coefficient, whichever applies to it
+     */
+    using IntegrateX = void (*)(strb::real* velocity, strb::real* position, const strb::real* friction, size_t count,
+        strb::real timescale);
+
+    /**
+     * @brief Adds gravity to the y velocity of bodies, caps it at their max velocity, then moves them along y by
+     * velocity * timescale.
+     */
+    using IntegrateY = void (*)(strb::real* velocity, strb::real* position, const strb::real* gravity,
+        const strb::real* maxVelocity, size_t count, strb::real timescale);
+
+    struct KernelSet {
+        const char* name;
+        IntegrateX integrateX;
+        IntegrateY integrateY;
+    };
+
+    const KernelSet& scalar();
+
+    /**
+     * @return The SSE2 kernels, or nullptr if the build or the CPU does not support them
+     */
+    const KernelSet* sse2();
+
+    /**
+     * @return The AVX2 kernels, or nullptr if the build or the CPU does not support them
+     */
+    const KernelSet* avx2();
+
+    /**
+     * @return The widest kernels the CPU supports
+     */
+    const KernelSet& best();
+}
+
+#endif
\ No newline at end of file
@@ -1,42 +1,50 @@
 #include "PhysicsSystem.h"
-#include "EntityRegistry.h"
+#include "EntityComponentSystem.h"
 #include "TransformComponent.h"
 #include "PhysicsComponent.h"
-#include "CollisionComponent.h"
+#include "DormantComponent.h"
 
 #include <iostream>
 #include <algorithm>
+#include <atomic>
 
 bool PhysicsSystem::updateX(float timescale) {
-    bool entityMoved = false;
-    auto ecs = EntityRegistry::getInstance();
-    for(auto ent : _entities) {
-        auto& physics = ecs->getComponent<PhysicsComponent>(ent);
-        auto& transform = ecs->getComponent<TransformComponent>(ent);
+    return (_kernels == nullptr) ? updateXEachBody(timescale) : updateXBatched(timescale);
+}
+
+bool PhysicsSystem::updateY(float timescale) {
+    return (_kernels == nullptr) ? updateYEachBody(timescale) : updateYBatched(timescale);
+}
+
+void PhysicsSystem::setLevel(Level level) {
+    _level = level;
+}
+
+void PhysicsSystem::setKernels(const physicsKernels::KernelSet* kernels) {
+    _kernels = kernels;
+}
 
+bool PhysicsSystem::updateXEachBody(float timescale) {
+    std::atomic<bool> entityMoved = false;
+    _ecs->view<PhysicsComponent, TransformComponent>().exclude<DormantComponent>().parallelEach(_threadPool, entityConstants::PARALLEL_BATCH_SIZE,
+        [&](size_t, Entity ent, PhysicsComponent& physics, TransformComponent& transform) {
         transform.lastPosition = transform.position; // always update this since last position is based on tile position previous turn
         if(physics.velocity.x != 0.f) {
-            entityMoved = true;
+            if(!entityMoved.load(std::memory_order_relaxed)) entityMoved.store(true, std::memory_order_relaxed);
             transform.position.x += physics.velocity.x * timescale;
-            float friction = (physics.touchingGround) ? physics.frictionCoefficient : physics.airFrictionCoefficient;
+            _ecs->markChanged<TransformComponent>(ent);
+            strb::real friction = (physics.touchingGround) ? physics.frictionCoefficient : physics.airFrictionCoefficient;
             moveToZero(physics.velocity.x, friction);
-            
-            if(ecs->hasComponent<CollisionComponent>(ent)) {
-                auto& collision = ecs->getComponent<CollisionComponent>(ent);
-                collision.collisionRect.x = transform.position.x + collision.collisionRectOffset.x;
-            }
         }
-    }
+    });
     return entityMoved;
 }
 
-bool PhysicsSystem::updateY(float timescale) {
-    bool entityMoved = false;
-    auto ecs = EntityRegistry::getInstance();
-    for(auto ent : _entities) {
-        entityMoved = true;
-        auto& physics = ecs->getComponent<PhysicsComponent>(ent);
-        auto& transform = ecs->getComponent<TransformComponent>(ent);
+bool PhysicsSystem::updateYEachBody(float timescale) {
+    std::atomic<bool> entityMoved = false;
+    _ecs->view<PhysicsComponent, TransformComponent>().exclude<DormantComponent>().parallelEach(_threadPool, entityConstants::PARALLEL_BATCH_SIZE,
+        [&](size_t, Entity ent, PhysicsComponent& physics, TransformComponent& transform) {
+        if(!entityMoved.load(std::memory_order_relaxed)) entityMoved.store(true, std::memory_order_relaxed);
 
         if(physics.touchingGround) {
             physics.offGroundCount = 0;
@@ -48,27 +56,114 @@ bool PhysicsSystem::updateY(float timescale) {
         physics.velocity.y += physics.gravity;
         if(physics.velocity.y > physics.maxVelocity.y) physics.velocity.y = physics.maxVelocity.y;
         transform.position.y += physics.velocity.y * timescale;
+        if(physics.velocity.y != 0.f) _ecs->markChanged<TransformComponent>(ent);
+    });
 
-        if(ecs->hasComponent<CollisionComponent>(ent)) {
-            auto& collision = ecs->getComponent<CollisionComponent>(ent);
-            collision.collisionRect.y = transform.position.y + collision.collisionRectOffset.y;
-        }
-    }
+    return entityMoved;
+}
+
+// The batched passes gather each batch's bodies into lanes, run the kernel over every batch, then write the results
+// back. Gathering and writing back stay per entity and run in parallel like the loops above; only the maths is batched.
+
+bool PhysicsSystem::updateXBatched(float timescale) {
+    auto view = _ecs->view<PhysicsComponent, TransformComponent>().exclude<DormantComponent>();
+    size_t batches = view.batchCount(entityConstants::PARALLEL_BATCH_SIZE);
+    if(_lanes.size() < batches) _lanes.resize(batches);
+
+    view.parallelEach(_threadPool, entityConstants::PARALLEL_BATCH_SIZE,
+        [&](size_t batch, Entity ent, PhysicsComponent& physics, TransformComponent& transform) {
+        transform.lastPosition = transform.position; // always update this since last position is based on tile position previous turn
+        // Bodies that are not moving on x are left out, since the kernel would leave them alone anyway
+        if(physics.velocity.x == 0.f) return;
+        auto& lanes = _lanes[batch];
+        size_t lane = lanes.add(ent, physics, transform);
+        lanes.velocity[lane] = physics.velocity.x;
+        lanes.position[lane] = transform.position.x;
+        lanes.friction[lane] = (physics.touchingGround) ? physics.frictionCoefficient : physics.airFrictionCoefficient;
+    });
 
+    std::atomic<bool> entityMoved = false;
+    forEachBatch(batches, [&](size_t batch) {
+        auto& lanes = _lanes[batch];
+        if(lanes.count == 0) return;
+        entityMoved.store(true, std::memory_order_relaxed);
+        _kernels->integrateX(lanes.velocity.data(), lanes.position.data(), lanes.friction.data(), lanes.count, timescale);
+        for(size_t i = 0; i < lanes.count; ++i) {
+            lanes.physics[i]->velocity.x = lanes.velocity[i];
+            lanes.transforms[i]->position.x = lanes.position[i];
+            _ecs->markChanged<TransformComponent>(lanes.entities[i]);
+        }
+        lanes.count = 0;
+    });
     return entityMoved;
 }
 
-void PhysicsSystem::setLevel(Level level) {
-    _level = level;
+bool PhysicsSystem::updateYBatched(float timescale) {
+    auto view = _ecs->view<PhysicsComponent, TransformComponent>().exclude<DormantComponent>();
+    size_t batches = view.batchCount(entityConstants::PARALLEL_BATCH_SIZE);
+    if(_lanes.size() < batches) _lanes.resize(batches);
+
+    view.parallelEach(_threadPool, entityConstants::PARALLEL_BATCH_SIZE,
+        [&](size_t batch, Entity ent, PhysicsComponent& physics, TransformComponent& transform) {
+        if(physics.touchingGround) {
+            physics.offGroundCount = 0;
+        }
+        else {
+            ++physics.offGroundCount;
+        }
+
+        auto& lanes = _lanes[batch];
+        size_t lane = lanes.add(ent, physics, transform);
+        lanes.velocity[lane] = physics.velocity.y;
+        lanes.position[lane] = transform.position.y;
+        lanes.gravity[lane] = physics.gravity;
+        lanes.maxVelocity[lane] = physics.maxVelocity.y;
+    });
+
+    std::atomic<bool> entityMoved = false;
+    forEachBatch(batches, [&](size_t batch) {
+        auto& lanes = _lanes[batch];
+        if(lanes.count == 0) return;
+        entityMoved.store(true, std::memory_order_relaxed);
+        _kernels->integrateY(lanes.velocity.data(), lanes.position.data(), lanes.gravity.data(),
+            lanes.maxVelocity.data(), lanes.count, timescale);
+        for(size_t i = 0; i < lanes.count; ++i) {
+            lanes.physics[i]->velocity.y = lanes.velocity[i];
+            lanes.transforms[i]->position.y = lanes.position[i];
+            if(lanes.velocity[i] != 0.f) _ecs->markChanged<TransformComponent>(lanes.entities[i]);
+        }
+        lanes.count = 0;
+    });
+
+    return entityMoved;
 }
 
-void PhysicsSystem::moveToZero(float &value, float amount) {
+void PhysicsSystem::moveToZero(strb::real &value, strb::real amount) {
     if(value != 0.f) {
         if(value > 0.f) {
             value = (value > amount) ? value - amount : 0.f;
         }
         else {
-            value = (std::abs(value) > amount) ? value + amount : 0.f;
+            value = (strb::abs(value) > amount) ? value + amount : 0.f;
         }
     }
+}
+
+size_t PhysicsSystem::BodyLanes::add(Entity ent, PhysicsComponent& physicsComp, TransformComponent& transform) {
+    if(count == entities.size()) resize(std::max(count * 2, entityConstants::PARALLEL_BATCH_SIZE));
+    entities[count] = ent;
+    physics[count] = &physicsComp;
+    transforms[count] = &transform;
+    return count++;
+}
+
+void PhysicsSystem::BodyLanes::resize(size_t size) {
+    entities.resize(size);
+    physics.resize(size);
+    transforms.resize(size);
+    velocity.resize(size);
+    position.resize(size);
+    friction.resize(size);
+    gravity.resize(size);
+    maxVelocity.resize(size);
 }
\ No newline at end of file
@@ -3,6 +3,12 @@
 
 #include "System.h"
 #include "Level.h"
+#include "PhysicsKernels.h"
+
+#include <vector>
+
+struct PhysicsComponent;
+struct TransformComponent;
 
 class PhysicsSystem : public System {
 public:
@@ -14,11 +20,66 @@ public:
 
     void setLevel(Level level);
 
+    /**
+     * @brief Integrates the bodies in batches with these kernels instead of one entity at a time. Both give the same
+     * result, but with the components laid out as they are the batches are slower (see bench/PhysicsBench.cpp), so
+     * this is off unless asked for.
+     *
+     * @param kernels The kernels to use, or nullptr to go back to the per-entity loop
+     */
+    void setKernels(const physicsKernels::KernelSet* kernels);
+
 private:
-    void moveToZero(float &value, float amount);
+    bool updateXEachBody(float timescale);
+    bool updateYEachBody(float timescale);
+    bool updateXBatched(float timescale);
+    bool updateYBatched(float timescale);
+    void moveToZero(strb::real &value, strb::real amount);
+
+    /**
+     * @brief One batch of bodies gathered for the kernels, one array per value. The pointers are where the results
+     * are written back to. Only the first count of each array are used. The arrays only grow, so once they fit a
+     * batch, gathering a body is a few plain stores.
+     */
+    struct BodyLanes {
+        size_t count = 0;
+        std::vector<Entity> entities;
+        std::vector<PhysicsComponent*> physics;
+        std::vector<TransformComponent*> transforms;
+        std::vector<strb::real> velocity;
+        std::vector<strb::real> position;
+        std::vector<strb::real> friction;
+        std::vector<strb::real> gravity;
+        std::vector<strb::real> maxVelocity;
+
+        /**
+         * @brief Puts the body in the next lane, growing the arrays if they are full. The caller fills in the values.
+         *
+         * @return The lane the body was put in
+         */
+        size_t add(Entity ent, PhysicsComponent& physicsComp, TransformComponent& transform);
+        void resize(size_t size);
+    };
+
+    /**
+     * @brief Calls func(batch) for every batch of lanes in [0, batches), in parallel if there is a pool to run them on.
+     */
+    template<typename Func>
+    void forEachBatch(size_t batches, Func func) {
+        if(_threadPool == nullptr || _threadPool->getThreadCount() == 0 || batches < 2) {
+            for(size_t batch = 0; batch < batches; ++batch) func(batch);
+        }
+        else {
+            _threadPool->parallelFor(batches, func);
+        }
+    }
 
     Level _level;
 
+    const physicsKernels::KernelSet* _kernels = nullptr;
+    // Reused every tick, so gathering does not allocate once the lanes have grown
+    std::vector<BodyLanes> _lanes;
+
 };
 
 #endif
\ No newline at end of file
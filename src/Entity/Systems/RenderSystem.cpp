@@ -1,5 +1,5 @@
 #include "RenderSystem.h"
-#include "EntityRegistry.h"
+#include "EntityComponentSystem.h"
 #include "RenderComponent.h"
 #include "TransformComponent.h"
 #include "SpritesheetPropertiesComponent.h"
@@ -8,49 +8,47 @@
 #include "AnimationComponent.h"
 #include "HealthComponent.h"
 #include "PlayerComponent.h"
+#include "PhysicsComponent.h"
 
 void RenderSystem::update(float timescale) {
-    auto ecs = EntityRegistry::getInstance();
-    for(auto ent : _entities) {
-        if(ecs->hasComponent<AnimationComponent>(ent)) {
-            auto& animationComponent = ecs->getComponent<AnimationComponent>(ent);
-            animationComponent.msSinceAnimationStart += timescale * 1000.f;
-        }
+    for(auto [ent, animationComponent, renderComponent] : _ecs->view<AnimationComponent, RenderComponent>()) {
+        animationComponent.msSinceAnimationStart += timescale * 1000.f;
     }
 }
 
-void RenderSystem::render(SDL_Renderer* renderer, int renderXOffset, int renderYOffset) {
-    auto ecs = EntityRegistry::getInstance();
+void RenderSystem::render(SDL_Renderer* renderer, int renderXOffset, int renderYOffset, float interpolation) {
     SDL_SetRenderDrawColor(renderer, 0xFF, 0x00, 0xFF, 0xFF);
-    for(auto ent : _entities) {
-        if(ecs->hasComponent<PlayerComponent>(ent) && ecs->getComponent<HealthComponent>(ent).hitpoints <= 0) continue;
-        auto& renderComponent = ecs->getComponent<RenderComponent>(ent);
-        auto& transform = ecs->getComponent<TransformComponent>(ent);
-        renderComponent.renderQuad.x = transform.position.x + renderComponent.renderQuadOffset.x;
-        renderComponent.renderQuad.y = transform.position.y + renderComponent.renderQuadOffset.y;
+    updateRenderQuads();
+    for(auto [ent, renderComponent, transform] : _ecs->view<RenderComponent, TransformComponent>()) {
+        if(_ecs->hasComponent<PlayerComponent>(ent) && _ecs->getComponent<HealthComponent>(ent).hitpoints <= 0) continue;
         SDL_Rect quad = renderComponent.renderQuad;
+        // Only physics keeps lastPosition up to date, and nothing else moves between ticks
+        if(interpolation < 1.f && _ecs->hasComponent<PhysicsComponent>(ent)) {
+            quad.x = (int) (transform.lastPosition.x + (transform.position.x - transform.lastPosition.x) * interpolation + renderComponent.renderQuadOffset.x);
+            quad.y = (int) (transform.lastPosition.y + (transform.position.y - transform.lastPosition.y) * interpolation + renderComponent.renderQuadOffset.y);
+        }
         quad.x += renderXOffset;
         quad.y += renderYOffset;
         // bounds check before rendering
         if(quad.x + quad.w > 0 && quad.x < _renderBounds.x &&
            quad.y + quad.h > 0 && quad.y < _renderBounds.y) {
+            auto propsPtr = _ecs->tryGetComponent<SpritesheetPropertiesComponent>(ent);
+            auto statePtr = _ecs->tryGetComponent<StateComponent>(ent);
+            auto directionPtr = _ecs->tryGetComponent<DirectionComponent>(ent);
             // if entity has spritesheet + required helper components
-            if(ecs->hasComponent<SpritesheetPropertiesComponent>(ent) &&
-               ecs->hasComponent<StateComponent>(ent) &&
-               ecs->hasComponent<DirectionComponent>(ent)) {
-                auto& propsComponent = ecs->getComponent<SpritesheetPropertiesComponent>(ent);
-                auto& state = ecs->getComponent<StateComponent>(ent).state;
-                auto& direction = ecs->getComponent<DirectionComponent>(ent).direction;
+            if(propsPtr && statePtr && directionPtr) {
+                auto& propsComponent = *propsPtr;
+                auto& state = statePtr->state;
+                auto& direction = directionPtr->direction;
                 SpritesheetProperties props = propsComponent.getSpritesheetProperties(state, direction);
                 propsComponent.spritesheet->setIsAnimated(props.isAnimated);
                 propsComponent.spritesheet->setIsLooped(props.isLooped);
                 propsComponent.spritesheet->setMsBetweenFrames(props.msBetweenFrames);
                 propsComponent.spritesheet->setNumOfFrames(props.numOfFrames);
                 if(props.isAnimated) {
-                    auto& animationComponent = ecs->getComponent<AnimationComponent>(ent);
-                    auto& state = ecs->getComponent<StateComponent>(ent);
+                    auto& animationComponent = _ecs->getComponent<AnimationComponent>(ent);
                     // check for change in y index to restart animation counter
-                    if(state.state != animationComponent.lastState) {
+                    if(state != animationComponent.lastState) {
                         animationComponent.msSinceAnimationStart = 0;
                     }
                     if(props.isLooped) {
@@ -61,13 +59,7 @@ void RenderSystem::render(SDL_Renderer* renderer, int renderXOffset, int renderY
                         if(animationComponent.xIndex >= props.numOfFrames) animationComponent.xIndex = props.numOfFrames - 1;
                     }
                     propsComponent.spritesheet->setTileIndex(animationComponent.xIndex, props.yTileIndex);
-                    animationComponent.lastState = state.state;
-                    if(ecs->hasComponent<StateComponent>(ent) &&
-                        ecs->hasComponent<DirectionComponent>(ent)) {
-                        auto& state = ecs->getComponent<StateComponent>(ent).state;
-                        auto& direction = ecs->getComponent<DirectionComponent>(ent).direction;
-                        propsComponent.addSpritesheetProperties(state, direction, props);
-                    }
+                    animationComponent.lastState = state;
                 }
                 else {
                     propsComponent.spritesheet->setTileIndex(props.xTileIndex, props.yTileIndex);
@@ -83,8 +75,8 @@ void RenderSystem::render(SDL_Renderer* renderer, int renderXOffset, int renderY
                 );
             }
             // else if entity has spritesheet at all
-            else if(ecs->hasComponent<SpritesheetPropertiesComponent>(ent)) {
-                auto& propsComponent = ecs->getComponent<SpritesheetPropertiesComponent>(ent);
+            else if(propsPtr) {
+                auto& propsComponent = *propsPtr;
                 SpritesheetProperties props = propsComponent.getPrimarySpritesheetProperties();
                 propsComponent.spritesheet->setIsAnimated(props.isAnimated);
                 propsComponent.spritesheet->setIsLooped(props.isLooped);
@@ -114,6 +106,15 @@ void RenderSystem::render(SDL_Renderer* renderer, int renderXOffset, int renderY
     }
 }
 
+void RenderSystem::updateRenderQuads() {
+    std::uint32_t since = _lastQuadSync;
+    _lastQuadSync = _ecs->advanceChangeTick();
+    for(auto [ent, renderComponent, transform] : _ecs->view<RenderComponent, TransformComponent>().changed<RenderComponent, TransformComponent>(since)) {
+        renderComponent.renderQuad.x = (int) (transform.position.x + renderComponent.renderQuadOffset.x);
+        renderComponent.renderQuad.y = (int) (transform.position.y + renderComponent.renderQuadOffset.y);
+    }
+}
+
 void RenderSystem::setRenderBounds(strb::vec2 renderBounds) {
     _renderBounds = renderBounds;
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "vec2.h"
 
 #include <SDL.h>
+#include <cstdint>
 
 class RenderSystem : public System {
 public:
@@ -12,12 +13,25 @@ public:
     ~RenderSystem() = default;
 
     void update(float timescale);
-    void render(SDL_Renderer* renderer, int renderXOffset = 0, int renderYOffset = 0);
+    /**
+     * @brief Renders every entity with a render component.
+     * 
+     * @param interpolation How far between the last two ticks to draw entities with physics, from 0 to 1. See
+     * State::setRenderInterpolation().
+     */
+    void render(SDL_Renderer* renderer, int renderXOffset = 0, int renderYOffset = 0, float interpolation = 1.f);
 
     void setRenderBounds(strb::vec2 renderBounds);
 
 private:
+    /**
+     * @brief Moves the render quad of every entity whose transform changed since the last render to match its position.
+     */
+    void updateRenderQuads();
+
     strb::vec2 _renderBounds = {0, 0};
+    // Change tick returned when the render quads were last brought up to date
+    std::uint32_t _lastQuadSync = 0;
 
 };
 
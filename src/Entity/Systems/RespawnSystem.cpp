@@ -1,6 +1,5 @@
 #include "RespawnSystem.h"
-#include "EntityRegistry.h"
+#include "EntityComponentSystem.h"
 
 void RespawnSystem::onEntityDelete(Entity entity) {
-    auto ecs = EntityRegistry::getInstance();
 }
\ No newline at end of file
@@ -1,11 +1,14 @@
 #include "ScriptSystem.h"
-#include "EntityRegistry.h"
+#include "EntityComponentSystem.h"
 #include "ScriptComponent.h"
+#include "DormantComponent.h"
 
 void ScriptSystem::update(float timescale) {
-    auto ecs = EntityRegistry::getInstance();
-    for(auto ent : _entities) {
-        auto& script = ecs->getComponent<ScriptComponent>(ent);
-        script.script->update(ent, timescale, _audioPlayer);
+    _entities.sort();
+    for(size_t i = _entities.size(); i-- > 0;) {
+        Entity ent = _entities[i];
+        if(_ecs->hasComponent<DormantComponent>(ent)) continue;
+        auto& script = _ecs->getComponent<ScriptComponent>(ent);
+        script.script->update(_ecs, ent, timescale, _audioPlayer);
     }
 }
\ No newline at end of file
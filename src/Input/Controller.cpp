@@ -94,16 +94,16 @@ bool Controller::isButtonReleased(SDL_GameControllerButton_Extended button) {
 int Controller::getAxisState(SDL_GameControllerAxis axis) {
     switch(axis) {
         case SDL_GameControllerAxis::SDL_CONTROLLER_AXIS_LEFTX: {
-            return calculateStickDirection(_leftAnalogXValue, _leftAnalogYValue).x;
+            return (int) calculateStickDirection(_leftAnalogXValue, _leftAnalogYValue).x;
         }
         case SDL_GameControllerAxis::SDL_CONTROLLER_AXIS_LEFTY: {
-            return calculateStickDirection(_leftAnalogXValue, _leftAnalogYValue).y;
+            return (int) calculateStickDirection(_leftAnalogXValue, _leftAnalogYValue).y;
         }
         case SDL_GameControllerAxis::SDL_CONTROLLER_AXIS_RIGHTX: {
-            return calculateStickDirection(_rightAnalogXValue, _rightAnalogYValue).x;
+            return (int) calculateStickDirection(_rightAnalogXValue, _rightAnalogYValue).x;
         }
         case SDL_GameControllerAxis::SDL_CONTROLLER_AXIS_RIGHTY: {
-            return calculateStickDirection(_rightAnalogXValue, _rightAnalogYValue).y;
+            return (int) calculateStickDirection(_rightAnalogXValue, _rightAnalogYValue).y;
         }
         default: {
             return 0;
@@ -114,16 +114,16 @@ int Controller::getAxisState(SDL_GameControllerAxis axis) {
 int Controller::getAxisStateLastTick(SDL_GameControllerAxis axis) {
     switch(axis) {
         case SDL_GameControllerAxis::SDL_CONTROLLER_AXIS_LEFTX: {
-            return calculateStickDirection(_lastLeftAnalogXValue, _lastLeftAnalogYValue).x;
+            return (int) calculateStickDirection(_lastLeftAnalogXValue, _lastLeftAnalogYValue).x;
         }
         case SDL_GameControllerAxis::SDL_CONTROLLER_AXIS_LEFTY: {
-            return calculateStickDirection(_lastLeftAnalogXValue, _lastLeftAnalogYValue).y;
+            return (int) calculateStickDirection(_lastLeftAnalogXValue, _lastLeftAnalogYValue).y;
         }
         case SDL_GameControllerAxis::SDL_CONTROLLER_AXIS_RIGHTX: {
-            return calculateStickDirection(_lastRightAnalogXValue, _lastRightAnalogYValue).x;
+            return (int) calculateStickDirection(_lastRightAnalogXValue, _lastRightAnalogYValue).x;
         }
         case SDL_GameControllerAxis::SDL_CONTROLLER_AXIS_RIGHTY: {
-            return calculateStickDirection(_lastRightAnalogXValue, _lastRightAnalogYValue).y;
+            return (int) calculateStickDirection(_lastRightAnalogXValue, _lastRightAnalogYValue).y;
         }
         default: {
             return 0;
@@ -1,5 +1,24 @@
 #include "Level.h"
 
+#include <algorithm>
+#include <cmath>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+    int countTrailingZeros(std::uint64_t bits) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return index;
+#else
+        return __builtin_ctzll(bits);
+#endif
+    }
+}
+
 void Level::render(int xOffset, int yOffset) {
     if(_tileset == nullptr) return;
     for(int x = 0; x < _tilemapWidth; ++x) {
@@ -28,6 +47,7 @@ void Level::setTilemap(std::vector<std::vector<Tile>> tilemap) {
     if(_tilemap.size() > 0) {
         _tilemapWidth = _tilemap[0].size();
     }
+    buildTileMasks();
 }
 
 void Level::setTileSize(int tileSize) {
@@ -36,7 +56,9 @@ void Level::setTileSize(int tileSize) {
 
 void Level::setTileAt(int x, int y, Tile tile) {
     if(x >= 0 && x < _tilemapWidth && y >= 0 && y < _tilemapHeight) {
+        setTileMaskBits(x, y, _tilemap[y][x].type, false);
         _tilemap[y][x] = tile;
+        setTileMaskBits(x, y, tile.type, true);
     }
 }
 
@@ -51,6 +73,109 @@ Tile Level::getTileAt(int x, int y) {
     return Tile{TileType::NOVAL, {0, 0, 0, 0}};
 }
 
+bool Level::isTileType(int x, int y, TileType type) const {
+    int mask = (int) type;
+    if(mask < 0 || mask >= TILE_TYPE_COUNT || x < 0 || x >= _tilemapWidth || y < 0 || y >= _tilemapHeight) return false;
+    return (_rowMasks[mask][y * _rowWords + x / 64] >> (x % 64)) & 1;
+}
+
+int Level::findTileInRow(TileType type, int y, int x0, int x1) const {
+    int mask = (int) type;
+    if(mask < 0 || mask >= TILE_TYPE_COUNT || y < 0 || y >= _tilemapHeight) return -1;
+    return findFirstBit(&_rowMasks[mask][y * _rowWords], std::max(x0, 0), std::min(x1, _tilemapWidth - 1));
+}
+
+int Level::findTileInColumn(TileType type, int x, int y0, int y1) const {
+    int mask = (int) type;
+    if(mask < 0 || mask >= TILE_TYPE_COUNT || x < 0 || x >= _tilemapWidth) return -1;
+    return findFirstBit(&_columnMasks[mask][x * _columnWords], std::max(y0, 0), std::min(y1, _tilemapHeight - 1));
+}
+
+TileSweep Level::sweepRect(strb::vec2 position, strb::vec2 size, strb::vec2 displacement,
+    std::initializer_list<TileType> blockingTypes) const {
+    TileSweep sweep;
+    if(displacement.x == 0.f && displacement.y == 0.f) return sweep;
+    strb::real tileSize = _tileSize;
+    // Times of 1 or more are past the end of the move, so they are all stored as NEVER. This also keeps them in
+    // range with a fixed-point real, where dividing by a tiny displacement would overflow.
+    const strb::real NEVER = 2;
+
+    // For each axis: the line (column or row) the leading edge enters next, the time it gets there and the time
+    // between lines. The leading edge enters a line as soon as it moves past the line's border, so a rect resting
+    // against a tile enters it at time 0.
+    int stepX = displacement.x > 0.f ? 1 : -1;
+    int stepY = displacement.y > 0.f ? 1 : -1;
+    int nextColumn = 0, nextRow = 0;
+    strb::real timeX = NEVER, timeY = NEVER, deltaX = NEVER, deltaY = NEVER;
+    if(displacement.x != 0.f) {
+        strb::real edge = displacement.x > 0.f ? position.x + size.x : position.x;
+        strb::real border = displacement.x > 0.f ? strb::ceil(edge / tileSize) : strb::floor(edge / tileSize);
+        nextColumn = displacement.x > 0.f ? (int) border : (int) border - 1;
+        strb::real distance = strb::abs(border * tileSize - edge);
+        strb::real speed = strb::abs(displacement.x);
+        if(distance < speed) timeX = distance / speed;
+        if(tileSize < speed) deltaX = tileSize / speed;
+    }
+    if(displacement.y != 0.f) {
+        strb::real edge = displacement.y > 0.f ? position.y + size.y : position.y;
+        strb::real border = displacement.y > 0.f ? strb::ceil(edge / tileSize) : strb::floor(edge / tileSize);
+        nextRow = displacement.y > 0.f ? (int) border : (int) border - 1;
+        strb::real distance = strb::abs(border * tileSize - edge);
+        strb::real speed = strb::abs(displacement.y);
+        if(distance < speed) timeY = distance / speed;
+        if(tileSize < speed) deltaY = tileSize / speed;
+    }
+
+    // Touching a line right at the end of the move is not entering it
+    while(std::min(timeX, timeY) < 1.f) {
+        bool crossX = timeX <= timeY;
+        strb::real time = crossX ? timeX : timeY;
+        // Where the rect spans on the other axis at that time. When both borders are crossed at once the line
+        // entered on the other axis counts too, so the tile on the diagonal isn't missed.
+        strb::real x = position.x + displacement.x * time;
+        strb::real y = position.y + displacement.y * time;
+        int first, last, hit;
+        if(crossX) {
+            first = (int) strb::floor(y / tileSize);
+            last = (int) strb::ceil((y + size.y) / tileSize) - 1;
+            if(timeY == timeX && stepY > 0) last = nextRow;
+            else if(timeY == timeX) first = nextRow;
+            hit = findBlockingTile(blockingTypes, true, nextColumn, first, last);
+        }
+        else {
+            first = (int) strb::floor(x / tileSize);
+            last = (int) strb::ceil((x + size.x) / tileSize) - 1;
+            hit = findBlockingTile(blockingTypes, false, nextRow, first, last);
+        }
+
+        if(hit != -1) {
+            sweep.hit = true;
+            sweep.time = time;
+            if(crossX) {
+                sweep.normal = {(float) -stepX, 0.f};
+                sweep.tileX = nextColumn;
+                sweep.tileY = hit;
+            }
+            else {
+                sweep.normal = {0.f, (float) -stepY};
+                sweep.tileX = hit;
+                sweep.tileY = nextRow;
+            }
+            return sweep;
+        }
+
+        if(crossX) {
+            nextColumn += stepX;
+            timeX += deltaX;
+        }
+        else {
+            nextRow += stepY;
+            timeY += deltaY;
+        }
+    }
+    return sweep;
+}
+
 int Level::getTileSize() {
     return _tileSize;
 }
@@ -61,4 +186,58 @@ int Level::getTilemapWidth() {
 
 int Level::getTilemapHeight() {
     return _tilemapHeight;
+}
+
+void Level::buildTileMasks() {
+    _rowWords = (_tilemapWidth + 63) / 64;
+    _columnWords = (_tilemapHeight + 63) / 64;
+    for(int mask = 0; mask < TILE_TYPE_COUNT; ++mask) {
+        _rowMasks[mask].assign(_tilemapHeight * _rowWords, 0);
+        _columnMasks[mask].assign(_tilemapWidth * _columnWords, 0);
+    }
+    for(int y = 0; y < _tilemapHeight; ++y) {
+        for(int x = 0; x < _tilemapWidth && x < (int) _tilemap[y].size(); ++x) {
+            setTileMaskBits(x, y, _tilemap[y][x].type, true);
+        }
+    }
+}
+
+void Level::setTileMaskBits(int x, int y, TileType type, bool value) {
+    int mask = (int) type;
+    if(mask < 0 || mask >= TILE_TYPE_COUNT) return;
+    std::uint64_t& rowWord = _rowMasks[mask][y * _rowWords + x / 64];
+    std::uint64_t& columnWord = _columnMasks[mask][x * _columnWords + y / 64];
+    std::uint64_t rowBit = std::uint64_t(1) << (x % 64);
+    std::uint64_t columnBit = std::uint64_t(1) << (y % 64);
+    if(value) {
+        rowWord |= rowBit;
+        columnWord |= columnBit;
+    }
+    else {
+        rowWord &= ~rowBit;
+        columnWord &= ~columnBit;
+    }
+}
+
+int Level::findFirstBit(const std::uint64_t* words, int first, int last) {
+    if(first > last) return -1;
+    int word = first / 64;
+    int lastWord = last / 64;
+    // Drop the bits before the span in the first word and after it in the last
+    std::uint64_t bits = words[word] & (~std::uint64_t(0) << (first % 64));
+    while(true) {
+        if(word == lastWord) bits &= ~std::uint64_t(0) >> (63 - last % 64);
+        if(bits != 0) return word * 64 + countTrailingZeros(bits);
+        if(word == lastWord) return -1;
+        bits = words[++word];
+    }
+}
+
+int Level::findBlockingTile(std::initializer_list<TileType> blockingTypes, bool inColumn, int line, int first, int last) const {
+    int closest = -1;
+    for(TileType type : blockingTypes) {
+        int found = inColumn ? findTileInColumn(type, line, first, last) : findTileInRow(type, line, first, last);
+        if(found != -1 && (closest == -1 || found < closest)) closest = found;
+    }
+    return closest;
 }
\ No newline at end of file
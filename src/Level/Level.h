@@ -3,9 +3,25 @@
 
 #include "Tile.h"
 #include "Spritesheet.h"
+#include "vec2.h"
 
+#include <cstdint>
+#include <initializer_list>
 #include <vector>
 
+/**
+ * @brief Result of Level::sweepRect().
+ */
+struct TileSweep {
+    bool hit = false;
+    // Fraction of the displacement covered before touching the tile, from 0 to 1
+    strb::real time = 1.f;
+    // Points out of the tile's face that was hit, e.g. {-1, 0} when moving right into the left side of a tile
+    strb::vec2 normal = {0.f, 0.f};
+    int tileX = -1;
+    int tileY = -1;
+};
+
 class Level {
 public:
     Level() = default;
@@ -19,12 +35,65 @@ public:
     void setTileset(Spritesheet* tileset);
 
     Tile getTileAt(int x, int y);
+    /**
+     * @brief Checks the tile's type against the level's bitmasks, without copying the tile.
+     * 
+     * @return True if the tile is inside the level and has the type. Always false for TileType::NOVAL.
+     */
+    bool isTileType(int x, int y, TileType type) const;
+    /**
+     * @brief Finds the leftmost tile of a type in part of a row with a bit scan.
+     * 
+     * @param x0 First column to search. Columns outside the level are skipped.
+     * @param x1 Last column to search, inclusive
+     * @return The tile's column, or -1 if there is none in the span or the row is outside the level
+     */
+    int findTileInRow(TileType type, int y, int x0, int x1) const;
+    /**
+     * @brief Finds the topmost tile of a type in part of a column with a bit scan.
+     * 
+     * @param y0 First row to search. Rows outside the level are skipped.
+     * @param y1 Last row to search, inclusive
+     * @return The tile's row, or -1 if there is none in the span or the column is outside the level
+     */
+    int findTileInColumn(TileType type, int x, int y0, int y1) const;
+    /**
+     * @brief Moves a rect along a displacement and finds the first tile of the given types it runs into. Walks the
+     * rows and columns the rect's leading edges cross in the order they are crossed (a DDA walk), so a fast mover
+     * can't skip over a tile. Tiles the rect already overlaps at the start are ignored, and tiles outside the level
+     * never block.
+     * 
+     * @param position Top left of the rect at the start of the move
+     * @param size Width and height of the rect
+     * @param displacement How far the rect moves
+     * @param blockingTypes The tile types that stop the rect
+     */
+    TileSweep sweepRect(strb::vec2 position, strb::vec2 size, strb::vec2 displacement,
+        std::initializer_list<TileType> blockingTypes) const;
     int getTileSize();
     int getTilemapWidth();
     int getTilemapHeight();
 
 private:
+    static constexpr int TILE_TYPE_COUNT = 3;
+
+    void buildTileMasks();
+    void setTileMaskBits(int x, int y, TileType type, bool value);
+    static int findFirstBit(const std::uint64_t* words, int first, int last);
+    /**
+     * @brief Finds the first blocking tile in part of a column (or row, if inColumn is false).
+     * 
+     * @return The tile's row (or column), or -1 if there is none
+     */
+    int findBlockingTile(std::initializer_list<TileType> blockingTypes, bool inColumn, int line, int first, int last) const;
+
     std::vector<std::vector<Tile>> _tilemap;
+    // One bit per tile for each tile type other than NOVAL. Rows are _rowWords words each, stored one after the
+    // other, and columns likewise, so a span of a row or a column can be searched a word at a time.
+    std::vector<std::uint64_t> _rowMasks[TILE_TYPE_COUNT];
+    std::vector<std::uint64_t> _columnMasks[TILE_TYPE_COUNT];
+    int _rowWords = 0;
+    int _columnWords = 0;
     int _tilemapWidth = 0;
     int _tilemapHeight = 0;
     int _tileSize = 16;
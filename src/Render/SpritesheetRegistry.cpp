@@ -0,0 +1,77 @@
+#include "SpritesheetRegistry.h"
+
+bool SpritesheetRegistry::loadSpritesheets(SDL_Renderer* renderer) {
+    std::shared_ptr<Spritesheet> dialogueSpritesheet = std::make_shared<Spritesheet>();
+    if(!dialogueSpritesheet->load(renderer, "res/spritesheet/dialogue_box.png")) return false;
+    dialogueSpritesheet->setTileWidth(320);
+    dialogueSpritesheet->setTileHeight(32);
+    addSpritesheet(SpritesheetID::DIALOGUE_BOX, dialogueSpritesheet);
+    
+    std::shared_ptr<Spritesheet> defaultTileset = std::make_shared<Spritesheet>();
+    if(!defaultTileset->load(renderer, "res/spritesheet/default_tileset.png")) return false;
+    defaultTileset->setTileWidth(16);
+    defaultTileset->setTileHeight(16);
+    addSpritesheet(SpritesheetID::DEFAULT_TILESET, defaultTileset);
+    
+    std::shared_ptr<Spritesheet> playerSpritesheet = std::make_shared<Spritesheet>();
+    if(!playerSpritesheet->load(renderer, "res/spritesheet/player.png")) return false;
+    playerSpritesheet->setTileWidth(24);
+    playerSpritesheet->setTileHeight(24);
+    addSpritesheet(SpritesheetID::PLAYER_SPRITESHEET, playerSpritesheet);
+    
+    std::shared_ptr<Spritesheet> checkpoint = std::make_shared<Spritesheet>();
+    if(!checkpoint->load(renderer, "res/spritesheet/checkpoint.png")) return false;
+    checkpoint->setTileWidth(16);
+    checkpoint->setTileHeight(16);
+    addSpritesheet(SpritesheetID::CHECKPOINT, checkpoint);
+    
+    std::shared_ptr<Spritesheet> weaponPickup = std::make_shared<Spritesheet>();
+    if(!weaponPickup->load(renderer, "res/spritesheet/weapon_pickup.png")) return false;
+    weaponPickup->setTileWidth(16);
+    weaponPickup->setTileHeight(16);
+    addSpritesheet(SpritesheetID::WEAPON_PICKUP, weaponPickup);
+    
+    std::shared_ptr<Spritesheet> jumpPickup = std::make_shared<Spritesheet>();
+    if(!jumpPickup->load(renderer, "res/spritesheet/jump_pickup.png")) return false;
+    jumpPickup->setTileWidth(16);
+    jumpPickup->setTileHeight(16);
+    addSpritesheet(SpritesheetID::JUMP_PICKUP, jumpPickup);
+    
+    std::shared_ptr<Spritesheet> bootsPickup = std::make_shared<Spritesheet>();
+    if(!bootsPickup->load(renderer, "res/spritesheet/boots_pickup.png")) return false;
+    bootsPickup->setTileWidth(16);
+    bootsPickup->setTileHeight(16);
+    addSpritesheet(SpritesheetID::BOOTS_PICKUP, bootsPickup);
+    
+    std::shared_ptr<Spritesheet> walljumpPickup = std::make_shared<Spritesheet>();
+    if(!walljumpPickup->load(renderer, "res/spritesheet/walljump_pickup.png")) return false;
+    walljumpPickup->setTileWidth(16);
+    walljumpPickup->setTileHeight(16);
+    addSpritesheet(SpritesheetID::WALLJUMP_PICKUP, walljumpPickup);
+    
+    std::shared_ptr<Spritesheet> projectile = std::make_shared<Spritesheet>();
+    if(!projectile->load(renderer, "res/spritesheet/projectile.png")) return false;
+    projectile->setTileWidth(8);
+    projectile->setTileHeight(8);
+    addSpritesheet(SpritesheetID::PROJECTILE, projectile);
+    
+    std::shared_ptr<Spritesheet> flag = std::make_shared<Spritesheet>();
+    if(!flag->load(renderer, "res/spritesheet/flag.png")) return false;
+    flag->setTileWidth(16);
+    flag->setTileHeight(16);
+    addSpritesheet(SpritesheetID::FLAG, flag);
+    
+    std::shared_ptr<Spritesheet> engineSpritesheet = std::make_shared<Spritesheet>();
+    if(!engineSpritesheet->load(renderer, "res/spritesheet/engine.png")) return false;
+    engineSpritesheet->setTileWidth(16);
+    engineSpritesheet->setTileHeight(16);
+    addSpritesheet(SpritesheetID::ENGINE_SPRITESHEET, engineSpritesheet);
+    
+    std::shared_ptr<Spritesheet> splashScreen = std::make_shared<Spritesheet>();
+    if(!splashScreen->load(renderer, "res/spritesheet/splash_screen.png")) return false;
+    splashScreen->setTileWidth(320);
+    splashScreen->setTileHeight(180);
+    addSpritesheet(SpritesheetID::SPLASH_SCREEN, splashScreen);
+
+    return true;
+}
\ No newline at end of file
@@ -22,6 +22,13 @@ public:
         return _spritesheets;
     }
 
+    /**
+     * @brief Loads every spritesheet the game uses and adds it to the registry.
+     * 
+     * @return False if any of them failed to load
+     */
+    static bool loadSpritesheets(SDL_Renderer* renderer);
+
 private:
     SpritesheetRegistry() = default;
 
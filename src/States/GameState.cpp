@@ -1,7 +1,7 @@
 #include "GameState.h"
 #include "RandomGen.h"
 #include "SpritesheetRegistry.h"
-#include "EntityRegistry.h"
+#include "EntityComponentSystem.h"
 #include "LevelParser.h"
 // Components
 #include "InputComponent.h"
@@ -16,6 +16,15 @@
 #include "ProjectileComponent.h"
 #include "BootsComponent.h"
 #include "EnemyComponent.h"
+#include "StateComponent.h"
+#include "EdgeCheckComponent.h"
+#include "PlayerComponent.h"
+#include "AnimationComponent.h"
+#include "GoalComponent.h"
+#include "PickupComponent.h"
+#include "DormantComponent.h"
+// Events
+#include "GameEvents.h"
 // Prefabs
 #include "Player.h"
 #include "Pickup.h"
@@ -23,13 +32,16 @@
 #include "Goal.h"
 #include "Engine.h"
 
+#include <algorithm>
 #include <chrono>
+#include <iostream>
+#include <thread>
 
 std::mt19937 RandomGen::randEng{(unsigned int) std::chrono::system_clock::now().time_since_epoch().count()};
 
 bool GameState::init() {
-    auto ecs = EntityRegistry::getInstance();
-    ecs->init();
+    _ecs = std::make_unique<EntityComponentSystem>();
+    _ecs->init();
 
     _keyboard = std::make_unique<Keyboard>();
     _mouse = std::make_unique<Mouse>(getRenderScale(), getRenderScale());
@@ -56,32 +68,32 @@ bool GameState::init() {
 
     // Prefabs
     strb::vec2 playerSpawn = {96, 168};
-    _player = prefab::Player::create(playerSpawn);
-    // ecs->addComponent<WalljumpComponent>(_player, WalljumpComponent{});
-    // ecs->addComponent<BootsComponent>(_player, BootsComponent{});
+    _player = prefab::Player::create(_ecs.get(), playerSpawn);
+    // _ecs->addComponent<WalljumpComponent>(_player, WalljumpComponent{});
+    // _ecs->addComponent<BootsComponent>(_player, BootsComponent{});
     
-    prefab::Pickup::create({56, 72}, PickupType::WEAPON);
-    prefab::Pickup::create({272, 168}, PickupType::JUMP);
-    prefab::Pickup::create({1584, 216}, PickupType::WALLJUMP);
-    prefab::Pickup::create({1160, 312}, PickupType::BOOTS);
-
-    prefab::Checkpoint::create({96, 176});
-    prefab::Checkpoint::create({608, 88});
-    prefab::Checkpoint::create({1120, 136});
-    prefab::Checkpoint::create({1552, 216});
-    prefab::Checkpoint::create({48, 344});
-    prefab::Checkpoint::create({656, 328});
-    prefab::Checkpoint::create({1080, 312});
+    prefab::Pickup::create(_ecs.get(), {56, 72}, PickupType::WEAPON);
+    prefab::Pickup::create(_ecs.get(), {272, 168}, PickupType::JUMP);
+    prefab::Pickup::create(_ecs.get(), {1584, 216}, PickupType::WALLJUMP);
+    prefab::Pickup::create(_ecs.get(), {1160, 312}, PickupType::BOOTS);
+
+    prefab::Checkpoint::create(_ecs.get(), {96, 176});
+    prefab::Checkpoint::create(_ecs.get(), {608, 88});
+    prefab::Checkpoint::create(_ecs.get(), {1120, 136});
+    prefab::Checkpoint::create(_ecs.get(), {1552, 216});
+    prefab::Checkpoint::create(_ecs.get(), {48, 344});
+    prefab::Checkpoint::create(_ecs.get(), {656, 328});
+    prefab::Checkpoint::create(_ecs.get(), {1080, 312});
 
     _engineSpawnList = {
         {1436, 48},
         {416, 336}
     };
 
-    prefab::Goal::create({1592, 336});
+    prefab::Goal::create(_ecs.get(), {1592, 336});
 
     // Other
-    ecs->addWatcher(_cameraSystem.get(), _player);
+    _ecs->addWatcher(_cameraSystem.get(), _player);
 
     _timer.setTimer(9999);
     _timer.setTimerResetDefault(9999);
@@ -93,12 +105,14 @@ bool GameState::init() {
     _dialogueBox.setText(getText(TextSize::TINY));
 
     respawnEngines();
+    // Respawn point until the player reaches a checkpoint
+    saveCheckpoint();
 
     return true;
 }
 
 void GameState::tick(float timescale) {
-    auto ecs = EntityRegistry::getInstance();
+    _simulationAdvanced = false;
 
     if(_gameOver) {
         if(_keyboard->isKeyReleased(SDL_SCANCODE_ESCAPE)) {
@@ -124,9 +138,8 @@ void GameState::tick(float timescale) {
         return;
     }
 
-    if(ecs->getComponent<HealthComponent>(_player).hitpoints <= 0) {
-        if(_deathTimer == 0) getAudioPlayer()->playAudio(_player, AudioSound::DEAD, 1.f);
-        _deathTimer += timescale * 1000.f;
+    if(_ecs->getComponent<HealthComponent>(_player).hitpoints <= 0) {
+        _deathTimer = (int) (_deathTimer + strb::real(timescale) * 1000);
         if(_deathTimer > 1500) resetState();
         return;
     }
@@ -136,108 +149,41 @@ void GameState::tick(float timescale) {
         resetState();
     }
 
-    _scriptSystem->update(timescale);
-
-    _inputSystem->update();
-
-    _physicsSystem->updateX(timescale);
-    _collisionSystem->checkForLevelCollisionsOnXAxis(&_level, timescale);
-    _physicsSystem->updateY(timescale);
-    _collisionSystem->checkForLevelCollisionsOnYAxis(&_level, timescale);
-    _collisionSystem->checkIfOnEdge(&_level);
-
-    _collisionSystem->checkForProjectileAndEnemyCollisions(timescale);
-
-    std::string pickupMessage = "";
-    PickupType pickupType;
-    if(_collisionSystem->checkForPlayerAndItemCollisions(_player, timescale, pickupMessage, pickupType)) {
-        if(pickupMessage.size() > 0) {
-            _dialogueBox.setString(pickupMessage);
-            _dialogueBox.reset();
-            _dialogueBox.setIsEnabled(true);
-            if(pickupType == PickupType::BOOTS) {
-                _engineSpawnList.push_back({192, 176});
-                _engineSpawnList.push_back({952, 120});
-                _engineSpawnList.push_back({1440, 336});
-                _engineSpawnList.push_back({1408, 176});
-                _engineSpawnList.push_back({680, 144});
-                _engineSpawnList.push_back({292, 320});
-                _engineSpawnList.push_back({848, 304});
-                respawnEngines();
-            }
-        }
+    _scheduler->run(timescale);
+    _simulationAdvanced = true;
+    handleDeaths();
+    if(_keyboard->isKeyPressed(SDL_SCANCODE_F3)) _scheduler->printTimings();
+    if(_keyboard->isKeyPressed(SDL_SCANCODE_F4)) _ecs->getStats().writeJson(std::cout);
+    // Saved once the whole tick has run, so a respawn starts from a clean tick boundary
+    if(_checkpointActivated) {
+        _checkpointActivated = false;
+        if(_ecs->getComponent<HealthComponent>(_player).hitpoints > 0) saveCheckpoint();
     }
-
-    Entity checkpoint;
-    if(_collisionSystem->checkForPlayerAndCheckpointCollisions(_player, timescale, checkpoint)) {
-        auto transform = ecs->getComponent<TransformComponent>(checkpoint);
-        _checkpointPos = {transform.position.x, transform.position.y - 8};
-        for(auto oldCheckpoint : ecs->getAllOf<CheckpointComponent>()) {
-            if(oldCheckpoint == checkpoint) {
-                auto& newCheckpointComp = ecs->getComponent<CheckpointComponent>(checkpoint);
-                newCheckpointComp.isActive = true;
-                if(!_wasCollidingWithCheckpointLastFrame) {
-                    _timer.reset();
-                    _wasCollidingWithCheckpointLastFrame = true;
-                    // this is not a great way to test but whateva
-                    if(!getAudioPlayer()->isPlaying(-1, AudioSound::CHECKPOINT_RESPAWN)) {
-                        newCheckpointComp.onActivatedScript->update(checkpoint, timescale, getAudioPlayer());
-                    }
-                }
-                continue;
-            }
-            auto& oldCheckpointComp = ecs->getComponent<CheckpointComponent>(oldCheckpoint);
-            auto& state = ecs->getComponent<StateComponent>(oldCheckpoint);
-            oldCheckpointComp.isActive = false;
-            state.state = EntityState::IDLE;
-        }
-    }
-    else {
-        _wasCollidingWithCheckpointLastFrame = false;
-    }
-    
-    Entity goal;
-    if(_collisionSystem->checkForPlayerAndGoalCollisions(_player, timescale, goal)) {
-        _gameOver = true;
-    }
-    
-    _collisionSystem->checkForPlayerAndEnemyCollisions(_player, timescale);
-
-    _deathSystem->update(timescale);
-
-    _renderSystem->update(timescale);
-
-    // Camera
-    auto& pTransform = ecs->getComponent<TransformComponent>(_player);
-    auto& pRender = ecs->getComponent<RenderComponent>(_player);
-    _cameraSystem->setGoalCameraOffset(pTransform.position.x + pRender.renderQuadOffset.x + pRender.renderQuad.w / 2 - getGameSize().x / 2,
-        pTransform.position.y + pRender.renderQuadOffset.y + pRender.renderQuad.h / 2 - getGameSize().y / 2);
-    _cameraSystem->update(timescale);
-
-    float playerXRemainder = pTransform.position.x - (int) pTransform.position.x;
-    float playerYRemainder = pTransform.position.y - (int) pTransform.position.y;
-    if(_cameraSystem->atXEdge()) playerXRemainder = 0.f;
-    if(_cameraSystem->atYEdge()) playerYRemainder = 0.f;
-    _renderOffset.x = (int) (_cameraSystem->getCurrentCameraOffset().x + playerXRemainder);
-    _renderOffset.y = (int) (_cameraSystem->getCurrentCameraOffset().y + playerYRemainder);
 }
 
 void GameState::render() {
     SDL_SetRenderDrawColor(getRenderer(), 0x00, 0x00, 0x00, 0xFF);
     SDL_RenderClear(getRenderer());
 
-    auto ecs = EntityRegistry::getInstance();
 
-    _level.render(_renderOffset.x, _renderOffset.y);
+    float interpolation = _simulationAdvanced ? getRenderInterpolation() : 1.f;
+    int renderXOffset = _renderOffset.x;
+    int renderYOffset = _renderOffset.y;
+    if(interpolation < 1.f) {
+        renderXOffset = _lastRenderOffset.x + (_renderOffset.x - _lastRenderOffset.x) * interpolation;
+        renderYOffset = _lastRenderOffset.y + (_renderOffset.y - _lastRenderOffset.y) * interpolation;
+    }
+
+    _level.render(renderXOffset, renderYOffset);
 
-    _renderSystem->render(getRenderer(), _renderOffset.x, _renderOffset.y);
+    _renderSystem->render(getRenderer(), renderXOffset, renderYOffset, interpolation);
 
-    if(_dialogueBox.isEnabled()) _dialogueBox.render(0, getGameSize().y - 32);
+    if(_dialogueBox.isEnabled()) _dialogueBox.render(0, (int) getGameSize().y - 32);
 
     // render timer
     Text* smallText = getText(TextSize::SMALL);
     smallText->setString(_timer.getTimerAsString());
-    int timerXPos = getGameSize().x / 2 - smallText->getWidth() / 2;
+    int timerXPos = (int) (getGameSize().x / 2 - smallText->getWidth() / 2);
     if(_timer.getMostRecentSecond() < 3) {
         smallText->render(timerXPos, 8, 255, 30, 30);
     }
@@ -248,67 +194,243 @@ void GameState::render() {
     // render game over
     if(_gameOver) {
         smallText->setString("You won!");
-        smallText->render(5, getGameSize().y - 30);
+        smallText->render(5, (int) getGameSize().y - 30);
         Text* tinyText = getText(TextSize::TINY);
         tinyText->setString("Press 'R' to restart or 'ESC' to quit.");
-        tinyText->render(5, getGameSize().y - 12);
+        tinyText->render(5, (int) getGameSize().y - 12);
     }
 
     SDL_RenderPresent(getRenderer());
 }
 
 void GameState::initSystems() {
-    auto ecs = EntityRegistry::getInstance();
     Signature sig;
 
     sig.reset();
-    _inputSystem = ecs->registerSystem<InputSystem>();
+    _inputSystem = _ecs->registerSystem<InputSystem>();
     _inputSystem->init(_keyboard.get(), _controller.get(), getSettings());
     _inputSystem->_audioPlayer = getAudioPlayer();
-    sig.set(ecs->getComponentType<InputComponent>(), true);
-    sig.set(ecs->getComponentType<PhysicsComponent>(), true);
-    ecs->setSystemSignature<InputSystem>(sig);
+    sig.set(_ecs->getComponentType<InputComponent>(), true);
+    sig.set(_ecs->getComponentType<PhysicsComponent>(), true);
+    _ecs->setSystemSignature<InputSystem>(sig);
 
     sig.reset();
-    _physicsSystem = ecs->registerSystem<PhysicsSystem>();
+    _physicsSystem = _ecs->registerSystem<PhysicsSystem>();
     _physicsSystem->setLevel(_level);
-    sig.set(ecs->getComponentType<TransformComponent>(), true);
-    sig.set(ecs->getComponentType<PhysicsComponent>(), true);
-    ecs->setSystemSignature<PhysicsSystem>(sig);
+    sig.set(_ecs->getComponentType<TransformComponent>(), true);
+    sig.set(_ecs->getComponentType<PhysicsComponent>(), true);
+    _ecs->setSystemSignature<PhysicsSystem>(sig);
 
     sig.reset();
-    _renderSystem = ecs->registerSystem<RenderSystem>();
+    _renderSystem = _ecs->registerSystem<RenderSystem>();
     _renderSystem->setRenderBounds(getGameSize());
-    sig.set(ecs->getComponentType<RenderComponent>(), true);
-    ecs->setSystemSignature<RenderSystem>(sig);
+    sig.set(_ecs->getComponentType<RenderComponent>(), true);
+    _ecs->setSystemSignature<RenderSystem>(sig);
     
     sig.reset();
-    _collisionSystem = ecs->registerSystem<CollisionSystem>();
+    _collisionSystem = _ecs->registerSystem<CollisionSystem>();
     _collisionSystem->_audioPlayer = getAudioPlayer();
-    sig.set(ecs->getComponentType<CollisionComponent>(), true);
-    sig.set(ecs->getComponentType<TransformComponent>(), true);
-    sig.set(ecs->getComponentType<PhysicsComponent>(), true);
-    ecs->setSystemSignature<CollisionSystem>(sig);
+    _collisionSystem->setBroadphaseCellSize(_level.getTileSize());
+    sig.set(_ecs->getComponentType<CollisionComponent>(), true);
+    sig.set(_ecs->getComponentType<TransformComponent>(), true);
+    sig.set(_ecs->getComponentType<PhysicsComponent>(), true);
+    _ecs->setSystemSignature<CollisionSystem>(sig);
     
     sig.reset();
-    _cameraSystem = ecs->registerSystem<CameraSystem>();
-    _cameraSystem->setGameSize(getGameSize().x, getGameSize().y);
+    _cameraSystem = _ecs->registerSystem<CameraSystem>();
+    _cameraSystem->setGameSize((int) getGameSize().x, (int) getGameSize().y);
     _cameraSystem->setLevelSize(_level.getTilemapWidth() * _level.getTileSize(),
         _level.getTilemapHeight() * _level.getTileSize());
     _cameraSystem->setMaxSpeed(300.f);
-    ecs->setSystemSignature<CameraSystem>(sig);
+    _ecs->setSystemSignature<CameraSystem>(sig);
+
+    sig.reset();
+    _activitySystem = _ecs->registerSystem<ActivitySystem>();
+    _activitySystem->setMargin(_level.getTileSize() * 8);
+    sig.set(_ecs->getComponentType<TransformComponent>());
+    sig.set(_ecs->getComponentType<EnemyComponent>());
+    _ecs->setSystemSignature<ActivitySystem>(sig);
 
     sig.reset();
-    _scriptSystem = ecs->registerSystem<ScriptSystem>();
+    _scriptSystem = _ecs->registerSystem<ScriptSystem>();
     _scriptSystem->_audioPlayer = getAudioPlayer();
-    sig.set(ecs->getComponentType<ScriptComponent>());
-    ecs->setSystemSignature<ScriptSystem>(sig);
+    sig.set(_ecs->getComponentType<ScriptComponent>());
+    _ecs->setSystemSignature<ScriptSystem>(sig);
 
     sig.reset();
-    _deathSystem = ecs->registerSystem<DeathSystem>();
+    _deathSystem = _ecs->registerSystem<DeathSystem>();
     _deathSystem->_audioPlayer = getAudioPlayer();
-    sig.set(ecs->getComponentType<HealthComponent>());
-    ecs->setSystemSignature<DeathSystem>(sig);
+    sig.set(_ecs->getComponentType<HealthComponent>());
+    _ecs->setSystemSignature<DeathSystem>(sig);
+
+    initScheduler();
+}
+
+void GameState::initScheduler() {
+    // The main thread runs systems too, so it doesn't need a worker of its own
+    size_t hardwareThreads = std::thread::hardware_concurrency();
+    _scheduler = std::make_unique<SystemScheduler>(hardwareThreads > 1 ? hardwareThreads - 1 : 0);
+#ifdef SINGLE_THREADED_SYSTEMS
+    _scheduler->setSingleThreaded(true);
+#endif
+    _physicsSystem->_threadPool = _scheduler->getThreadPool();
+    _collisionSystem->_threadPool = _scheduler->getThreadPool();
+
+    // Anything that runs scripts, plays audio, creates entities or touches game state is exclusive
+    // Uses where the camera ended up last tick, so every system below agrees on which entities are dormant
+    _scheduler->addTask("activity", SystemAccess::all(), [this](float) {
+        strb::vec2 cameraPosition = _cameraSystem->getCurrentCameraOffset() * -1.f;
+        _activitySystem->update({(int) cameraPosition.x, (int) cameraPosition.y, (int) getGameSize().x, (int) getGameSize().y});
+    });
+    _scheduler->addTask("scripts", SystemAccess::all(), [this](float timescale) {
+        _scriptSystem->update(timescale);
+    });
+    _scheduler->addTask("input", SystemAccess::all(), [this](float) {
+        _inputSystem->update();
+    });
+    _scheduler->addTask("physics x", SystemAccess().read<DormantComponent>().write<PhysicsComponent, TransformComponent>(),
+        [this](float timescale) {
+        _physicsSystem->updateX(timescale);
+    });
+    _scheduler->addTask("level collisions x", SystemAccess()
+        .read<ProjectileComponent, DormantComponent>()
+        .write<CollisionComponent, PhysicsComponent, TransformComponent, StateComponent>()
+        .recordCommands(), [this](float timescale) {
+        _collisionSystem->checkForLevelCollisionsOnXAxis(&_level, timescale);
+    });
+    _scheduler->addTask("physics y", SystemAccess().read<DormantComponent>().write<PhysicsComponent, TransformComponent>(),
+        [this](float timescale) {
+        _physicsSystem->updateY(timescale);
+    });
+    _scheduler->addTask("level collisions y", SystemAccess()
+        .read<ProjectileComponent, BootsComponent, DormantComponent>()
+        .write<CollisionComponent, PhysicsComponent, TransformComponent, HealthComponent>()
+        .recordCommands(), [this](float timescale) {
+        _collisionSystem->checkForLevelCollisionsOnYAxis(&_level, timescale);
+    });
+    _scheduler->addTask("edge checks", SystemAccess().read<PhysicsComponent, CollisionComponent, DormantComponent>().write<EdgeCheckComponent>(),
+        [this](float) {
+        _collisionSystem->checkIfOnEdge(&_level);
+    });
+    // Projectiles that hit a wall are gone before they can hit anything else
+    _scheduler->addTask("flush", SystemAccess::all(), [this](float) {
+        _ecs->flushCommands();
+    });
+    _scheduler->addTask("collision rects", SystemAccess().read<TransformComponent>().write<CollisionComponent>(),
+        [this](float) {
+        _collisionSystem->updateCollisionRects();
+    });
+    _scheduler->addTask("projectile collisions", SystemAccess()
+        .read<ProjectileComponent, TransformComponent, PlayerComponent>()
+        .write<CollisionComponent, HealthComponent, PhysicsComponent>()
+        .recordCommands(), [this](float timescale) {
+        _collisionSystem->checkForProjectileAndEnemyCollisions(timescale);
+    });
+    _scheduler->addTask("pickup collisions", SystemAccess::all(), [this](float timescale) {
+        _collisionSystem->checkForPlayerAndItemCollisions(_player, timescale);
+    });
+    _scheduler->addTask("checkpoint collisions", SystemAccess().read<CollisionComponent>().write<CheckpointComponent>(),
+        [this](float timescale) {
+        _collisionSystem->checkForPlayerAndCheckpointCollisions(_player, timescale);
+    });
+    _scheduler->addTask("goal collisions", SystemAccess::all(), [this](float timescale) {
+        _collisionSystem->checkForPlayerAndGoalCollisions(_player, timescale);
+    });
+    // Reacts to everything the collision checks above published, before the engines are checked against the player
+    _scheduler->addTask("game events", SystemAccess::all(), [this](float timescale) {
+        handlePickups();
+        handleCheckpoints(timescale);
+        handleCollisions();
+    });
+    _scheduler->addTask("enemy collisions", SystemAccess()
+        .read<EnemyComponent, CollisionComponent, TransformComponent>()
+        .write<PhysicsComponent, HealthComponent>(), [this](float timescale) {
+        _collisionSystem->checkForPlayerAndEnemyCollisions(_player, timescale);
+    });
+    _scheduler->addTask("death", SystemAccess().read<HealthComponent, PlayerComponent>().recordCommands(),
+        [this](float timescale) {
+        _deathSystem->update(timescale);
+    });
+    // Only animation timers, so this runs alongside the enemy collision and death checks
+    _scheduler->addTask("animation", SystemAccess().read<RenderComponent>().write<AnimationComponent>(),
+        [this](float timescale) {
+        _renderSystem->update(timescale);
+    });
+    // Destroys whatever the collision and death systems queued up this frame
+    _scheduler->addTask("flush", SystemAccess::all(), [this](float) {
+        _ecs->flushCommands();
+    });
+    _scheduler->addTask("camera", SystemAccess::all(), [this](float timescale) {
+        updateCamera(timescale);
+    });
+}
+
+void GameState::handlePickups() {
+    _ecs->getEventBus().drain<PickupEvent>([this](const PickupEvent& event) {
+        if(event.message.empty()) return;
+        _dialogueBox.setString(event.message);
+        _dialogueBox.reset();
+        _dialogueBox.setIsEnabled(true);
+        if(event.pickupType == PickupType::BOOTS) {
+            _engineSpawnList.push_back({192, 176});
+            _engineSpawnList.push_back({952, 120});
+            _engineSpawnList.push_back({1440, 336});
+            _engineSpawnList.push_back({1408, 176});
+            _engineSpawnList.push_back({680, 144});
+            _engineSpawnList.push_back({292, 320});
+            _engineSpawnList.push_back({848, 304});
+            respawnEngines();
+        }
+    });
+}
+
+void GameState::handleCheckpoints(float timescale) {
+    _ecs->getEventBus().drain<CheckpointActivatedEvent>([&](const CheckpointActivatedEvent& event) {
+        Entity checkpoint = event.checkpoint;
+        for(auto oldCheckpoint : _ecs->getAllOf<CheckpointComponent>()) {
+            if(oldCheckpoint == checkpoint) continue;
+            auto& oldCheckpointComp = _ecs->getComponent<CheckpointComponent>(oldCheckpoint);
+            auto& state = _ecs->getComponent<StateComponent>(oldCheckpoint);
+            oldCheckpointComp.isActive = false;
+            state.state = EntityState::IDLE;
+        }
+        auto& newCheckpointComp = _ecs->getComponent<CheckpointComponent>(checkpoint);
+        newCheckpointComp.isActive = true;
+        _checkpointActivated = true;
+        _timer.reset();
+        // this is not a great way to test but whateva
+        if(!getAudioPlayer()->isPlaying(-1, AudioSound::CHECKPOINT_RESPAWN)) {
+            newCheckpointComp.onActivatedScript->update(_ecs.get(), checkpoint, timescale, getAudioPlayer());
+        }
+    });
+}
+
+void GameState::handleCollisions() {
+    _ecs->getEventBus().drain<CollisionBeginEvent>([&](const CollisionBeginEvent& event) {
+        if(event.entity == _player && _ecs->hasComponent<GoalComponent>(event.other)) _gameOver = true;
+    });
+}
+
+void GameState::handleDeaths() {
+    _ecs->getEventBus().drain<DeathEvent>([this](const DeathEvent& event) {
+        if(event.entity == _player) getAudioPlayer()->playAudio(_player, AudioSound::DEAD, 1.f);
+    });
+}
+
+void GameState::updateCamera(float timescale) {
+    auto& pTransform = _ecs->getComponent<TransformComponent>(_player);
+    auto& pRender = _ecs->getComponent<RenderComponent>(_player);
+    _cameraSystem->setGoalCameraOffset(pTransform.position.x + pRender.renderQuadOffset.x + pRender.renderQuad.w / 2 - getGameSize().x / 2,
+        pTransform.position.y + pRender.renderQuadOffset.y + pRender.renderQuad.h / 2 - getGameSize().y / 2);
+    _cameraSystem->update(timescale);
+    _lastRenderOffset = _renderOffset;
+
+    strb::real playerXRemainder = pTransform.position.x - (int) pTransform.position.x;
+    strb::real playerYRemainder = pTransform.position.y - (int) pTransform.position.y;
+    if(_cameraSystem->atXEdge()) playerXRemainder = 0.f;
+    if(_cameraSystem->atYEdge()) playerYRemainder = 0.f;
+    _renderOffset.x = (int) (_cameraSystem->getCurrentCameraOffset().x + playerXRemainder);
+    _renderOffset.y = (int) (_cameraSystem->getCurrentCameraOffset().y + playerYRemainder);
 }
 
 void GameState::handleControllerButtonInput(SDL_Event e) {
@@ -323,28 +445,41 @@ void GameState::handleMouseInput(SDL_Event e) {
     _mouse->updateInput(e, _renderOffset.x, _renderOffset.y);
 }
 
+EntityComponentSystem* GameState::getWorld() {
+    return _ecs.get();
+}
+
+Entity GameState::getPlayer() {
+    return _player;
+}
+
+PhysicsSystem* GameState::getPhysicsSystem() {
+    return _physicsSystem.get();
+}
+
 void GameState::resetState() {
-    auto ecs = EntityRegistry::getInstance();
-    auto& transform = ecs->getComponent<TransformComponent>(_player);
-    auto& collision = ecs->getComponent<CollisionComponent>(_player);
-    transform.position = _checkpointPos;
-    transform.lastPosition = _checkpointPos;
-    collision.collisionRect.x = transform.position.x + collision.collisionRectOffset.x;
-    collision.collisionRect.y = transform.position.y + collision.collisionRectOffset.y;
+    // The player, enemies and pickups all go back to how they were when the checkpoint was activated
+    _ecs->restoreSnapshot(_checkpointSave.world);
+    _engineSpawnList = _checkpointSave.engineSpawnList;
     _timer.reset();
-    getAudioPlayer()->playAudio(-1, AudioSound::CHECKPOINT_RESPAWN, 0.8f);
-    auto& health = ecs->getComponent<HealthComponent>(_player);
-    health.hitpoints = 1;
     _deathTimer = 0;
-    respawnEngines();
+    getAudioPlayer()->playAudio(-1, AudioSound::CHECKPOINT_RESPAWN, 0.8f);
+}
+
+void GameState::saveCheckpoint() {
+    _ecs->captureSnapshot(_checkpointSave.world);
+    _checkpointSave.engineSpawnList = _engineSpawnList;
 }
 
 void GameState::respawnEngines() {
-    auto ecs = EntityRegistry::getInstance();
-    for(auto ent : ecs->getAllOf<EnemyComponent>()) {
-        ecs->destroyEntity(ent);
-    }
-    for(auto pos : _engineSpawnList) {
-        prefab::Engine::create(pos);
+    auto allEngines = _ecs->getAllOf<EnemyComponent>();
+    // Archetype storage lists dormant engines apart from the rest, so free their slots in the same order either way
+    std::vector<Entity> engines(allEngines.begin(), allEngines.end());
+    std::sort(engines.begin(), engines.end(), [](Entity a, Entity b) {
+        return entityHandle::getIndex(a) < entityHandle::getIndex(b);
+    });
+    for(size_t i = engines.size(); i-- > 0;) {
+        _ecs->destroyEntity(engines[i]);
     }
+    prefab::Engine::create(_ecs.get(), _engineSpawnList);
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "Timer.h"
 #include "DialogueBox.h"
 // Systems
+#include "ActivitySystem.h"
 #include "RenderSystem.h"
 #include "CollisionSystem.h"
 #include "PhysicsSystem.h"
@@ -16,11 +17,13 @@
 #include "CameraSystem.h"
 #include "ScriptSystem.h"
 #include "DeathSystem.h"
+#include "SystemScheduler.h"
+#include "EntityComponentSystem.h"
 
 #include <memory>
 #include <cstdint>
 
-using Entity = std::uint16_t;
+using Entity = std::uint32_t;
 
 class GameState: public State {
 public:
@@ -36,9 +39,22 @@ public:
     void handleControllerAxisInput(SDL_Event e) override;
     void handleMouseInput(SDL_Event e) override;
 
+    // For tests and tools that drive the simulation without the rest of the game
+    EntityComponentSystem* getWorld();
+    Entity getPlayer();
+    PhysicsSystem* getPhysicsSystem();
+
 private:
+    void initScheduler();
     void resetState();
     void respawnEngines();
+    // Event handlers, each draining its event type from the ECS event bus
+    void handlePickups();
+    void handleCheckpoints(float timescale);
+    void handleCollisions();
+    void handleDeaths();
+    void updateCamera(float timescale);
+    void saveCheckpoint();
 
     std::unique_ptr<Keyboard> _keyboard = nullptr;
     std::unique_ptr<Mouse> _mouse = nullptr;
@@ -47,15 +63,27 @@ private:
     Level _level;
 
     SDL_FPoint _renderOffset = {0.f, 0.f};
+    // The render offset before the last camera update, to interpolate from
+    SDL_FPoint _lastRenderOffset = {0.f, 0.f};
+    // Whether the last tick ran the simulation. Paused ticks move nothing, so there is nothing to interpolate.
+    bool _simulationAdvanced = false;
+
+    // The world this state simulates. Systems, prefabs and scripts are all handed this rather than finding it
+    // themselves.
+    std::unique_ptr<EntityComponentSystem> _ecs = nullptr;
 
     std::shared_ptr<RenderSystem> _renderSystem = nullptr;
     std::shared_ptr<CollisionSystem> _collisionSystem = nullptr;
     std::shared_ptr<PhysicsSystem> _physicsSystem = nullptr;
     std::shared_ptr<InputSystem> _inputSystem = nullptr;
     std::shared_ptr<CameraSystem> _cameraSystem = nullptr;
+    std::shared_ptr<ActivitySystem> _activitySystem = nullptr;
     std::shared_ptr<ScriptSystem> _scriptSystem = nullptr;
     std::shared_ptr<DeathSystem> _deathSystem = nullptr;
 
+    // Runs the systems each tick, in the order they were added
+    std::unique_ptr<SystemScheduler> _scheduler = nullptr;
+
     Entity _player;
 
     Timer _timer;
@@ -63,12 +91,21 @@ private:
 
     DialogueBox _dialogueBox;
 
-    strb::vec2 _checkpointPos = {0.f, 0.f};
-
     std::vector<strb::vec2> _engineSpawnList;
 
     bool _gameOver = false;
-    bool _wasCollidingWithCheckpointLastFrame = false;
+
+    /**
+     * @brief What a respawn restores: the whole world plus the game state kept outside of it, as it was at the end
+     * of the tick the last checkpoint was activated in.
+     */
+    struct CheckpointSave {
+        WorldSnapshot world;
+        std::vector<strb::vec2> engineSpawnList;
+    };
+    CheckpointSave _checkpointSave;
+    // Set when a checkpoint is activated, so that the save is taken once the tick is over
+    bool _checkpointActivated = false;
 };
 
 #endif
\ No newline at end of file
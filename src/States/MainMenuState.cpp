@@ -23,13 +23,13 @@ void MainMenuState::render() {
     SDL_SetRenderDrawColor(getRenderer(), 0x00, 0x00, 0x00, 0xFF);
     SDL_RenderClear(getRenderer());
     
-    SpritesheetRegistry::getSpritesheet(SpritesheetID::SPLASH_SCREEN)->render(0, 0, getGameSize().x, getGameSize().y);
+    SpritesheetRegistry::getSpritesheet(SpritesheetID::SPLASH_SCREEN)->render(0, 0, (int) getGameSize().x, (int) getGameSize().y);
 
     Text* mediumText = getText(TextSize::SMALL);
     mediumText->setString("Arrow keys to move");
-    mediumText->render(getGameSize().x / 2 - mediumText->getWidth() / 2 - 20, 100);
+    mediumText->render((int) (getGameSize().x / 2 - mediumText->getWidth() / 2 - 20), 100);
     mediumText->setString("Press 'Z' to start");
-    mediumText->render(getGameSize().x / 2 - mediumText->getWidth() / 2 - 20, 115);
+    mediumText->render((int) (getGameSize().x / 2 - mediumText->getWidth() / 2 - 20), 115);
 
     SDL_RenderPresent(getRenderer());
 }
@@ -43,5 +43,5 @@ void MainMenuState::handleControllerAxisInput(SDL_Event e) {
 }
 
 void MainMenuState::handleMouseInput(SDL_Event e) {
-    _mouse->updateInput(e, _renderOffset.x, _renderOffset.y);
+    _mouse->updateInput(e, (int) _renderOffset.x, (int) _renderOffset.y);
 }
\ No newline at end of file
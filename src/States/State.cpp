@@ -21,6 +21,10 @@ void State::setRenderScale(int scale) {
     _renderScale = scale;
 }
 
+void State::setRenderInterpolation(float alpha) {
+    _renderInterpolation = alpha;
+}
+
 void State::addText(TextSize size, Text* text) {
     _text[size] = text;
 }
@@ -53,6 +57,10 @@ int State::getRenderScale() {
     return _renderScale;
 }
 
+float State::getRenderInterpolation() {
+    return _renderInterpolation;
+}
+
 Text* State::getText(TextSize size) {
     return _text[size];
 }
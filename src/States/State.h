@@ -39,6 +39,12 @@ public:
     void setNextState(State* state);
     void setRenderer(SDL_Renderer* renderer);
     void setRenderScale(int scale);
+    /**
+     * @brief Sets how far rendering is between the last two ticks, from 0 (the one before last) to 1 (the last).
+     * The game ticks at a fixed rate but renders as often as the display allows, so moving things are drawn part
+     * way between where they were and where they are.
+     */
+    void setRenderInterpolation(float alpha);
     void addText(TextSize size, Text* text);
     void setAudioPlayer(Audio* audioPlayer);
     void setSettings(Settings* settings);
@@ -48,6 +54,7 @@ public:
     State* getNextState();
     SDL_Renderer* getRenderer();
     int getRenderScale();
+    float getRenderInterpolation();
     Text* getText(TextSize size);
     Audio* getAudioPlayer();
     Settings* getSettings();
@@ -62,6 +69,7 @@ private:
     State* _nextState = nullptr;
     SDL_Renderer* _renderer = nullptr;
     int _renderScale = 1;
+    float _renderInterpolation = 1.f;
     std::unordered_map<TextSize, Text*> _text;
     Audio* _audioPlayer = nullptr;
     Settings* _settings = nullptr;
@@ -0,0 +1,130 @@
+#include "HeadlessPlatform.h"
+#include "Audio.h"
+
+#include <SDL_image.h>
+#include <SDL_ttf.h>
+#include <cstdio>
+
+namespace {
+    Uint8 keys[SDL_NUM_SCANCODES] = {};
+
+    // Nothing is drawn, so any non-null handle will do for textures and fonts
+    char dummyHandle;
+
+    // Only the size of an image is ever read, so surfaces share one blank surface with the size filled in
+    SDL_Surface surface = {};
+
+    // Reads the size of a PNG from its header, or returns false if the file is not a PNG
+    bool readPngSize(const char* path, int& w, int& h) {
+        std::FILE* file = std::fopen(path, "rb");
+        if(file == nullptr) return false;
+        unsigned char header[24];
+        bool read = std::fread(header, 1, sizeof(header), file) == sizeof(header);
+        std::fclose(file);
+        const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        for(int i = 0; read && i < 8; ++i) {
+            if(header[i] != signature[i]) read = false;
+        }
+        if(!read) return false;
+        w = (header[16] << 24) | (header[17] << 16) | (header[18] << 8) | header[19];
+        h = (header[20] << 24) | (header[21] << 16) | (header[22] << 8) | header[23];
+        return true;
+    }
+}
+
+namespace headless {
+    void setKeyDown(SDL_Scancode key, bool down) {
+        keys[key] = down ? 1 : 0;
+    }
+
+    void releaseAllKeys() {
+        for(auto& key : keys) key = 0;
+    }
+}
+
+// SDL
+
+const Uint8* SDL_GetKeyboardState(int* numkeys) {
+    if(numkeys != nullptr) *numkeys = SDL_NUM_SCANCODES;
+    return keys;
+}
+
+Uint32 SDL_GetMouseState(int* x, int* y) {
+    if(x != nullptr) *x = 0;
+    if(y != nullptr) *y = 0;
+    return 0;
+}
+
+char* SDL_GetBasePath() {
+    static char path[] = LD51_SOURCE_DIR "/";
+    return path;
+}
+
+const char* SDL_GetError() {
+    return "";
+}
+
+SDL_bool SDL_HasIntersection(const SDL_Rect* a, const SDL_Rect* b) {
+    if(a == nullptr || b == nullptr || a->w <= 0 || a->h <= 0 || b->w <= 0 || b->h <= 0) return SDL_FALSE;
+    bool overlapX = a->x < b->x + b->w && b->x < a->x + a->w;
+    bool overlapY = a->y < b->y + b->h && b->y < a->y + a->h;
+    return (overlapX && overlapY) ? SDL_TRUE : SDL_FALSE;
+}
+
+SDL_Texture* SDL_CreateTextureFromSurface(SDL_Renderer*, SDL_Surface*) {
+    return reinterpret_cast<SDL_Texture*>(&dummyHandle);
+}
+
+void SDL_DestroyTexture(SDL_Texture*) {}
+void SDL_FreeSurface(SDL_Surface*) {}
+int SDL_SetTextureColorMod(SDL_Texture*, Uint8, Uint8, Uint8) { return 0; }
+int SDL_SetTextureAlphaMod(SDL_Texture*, Uint8) { return 0; }
+int SDL_SetRenderDrawColor(SDL_Renderer*, Uint8, Uint8, Uint8, Uint8) { return 0; }
+int SDL_RenderClear(SDL_Renderer*) { return 0; }
+int SDL_RenderFillRect(SDL_Renderer*, const SDL_Rect*) { return 0; }
+int SDL_RenderCopy(SDL_Renderer*, SDL_Texture*, const SDL_Rect*, const SDL_Rect*) { return 0; }
+int SDL_RenderCopyEx(SDL_Renderer*, SDL_Texture*, const SDL_Rect*, const SDL_Rect*, double, const SDL_Point*,
+    SDL_RendererFlip) { return 0; }
+void SDL_RenderPresent(SDL_Renderer*) {}
+
+// SDL_image and SDL_ttf. Their GetError functions are usually macros for SDL_GetError.
+
+SDL_Surface* IMG_Load(const char* file) {
+    if(!readPngSize(file, surface.w, surface.h)) return nullptr;
+    return &surface;
+}
+
+#ifndef IMG_GetError
+const char* IMG_GetError() {
+    return "";
+}
+#endif
+
+TTF_Font* TTF_OpenFont(const char*, int) {
+    return reinterpret_cast<TTF_Font*>(&dummyHandle);
+}
+
+void TTF_CloseFont(TTF_Font*) {}
+
+SDL_Surface* TTF_RenderGlyph_Solid(TTF_Font*, Uint16, SDL_Color) {
+    surface.w = 8;
+    surface.h = 8;
+    return &surface;
+}
+
+#ifndef TTF_GetError
+const char* TTF_GetError() {
+    return "";
+}
+#endif
+
+// Audio
+
+Audio::Audio() {}
+Audio::~Audio() {}
+bool Audio::addAudio(AudioSound, const char*) { return true; }
+void Audio::playAudio(int, AudioSound, float, bool) {}
+void Audio::stopAudio(int, AudioSound) {}
+void Audio::stopAllAudioById(int) {}
+void Audio::stopAllAudio() {}
+bool Audio::isPlaying(int, AudioSound) { return false; }
\ No newline at end of file
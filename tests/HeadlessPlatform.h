@@ -0,0 +1,16 @@
+#ifndef HEADLESS_PLATFORM_H
+#define HEADLESS_PLATFORM_H
+
+#include <SDL.h>
+
+/**
+ * @brief Stands in for SDL, SDL_image, SDL_ttf and the audio player, so that tests and benchmarks can run the game
+ * without a window, sound or the SDL libraries (only their headers). Rendering and audio do nothing, images are only
+ * read for their size, and the keyboard holds whatever keys are set here.
+ */
+namespace headless {
+    void setKeyDown(SDL_Scancode key, bool down);
+    void releaseAllKeys();
+}
+
+#endif
\ No newline at end of file
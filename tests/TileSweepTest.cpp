@@ -0,0 +1,138 @@
+#include "HeadlessPlatform.h"
+#include "EntityComponentSystem.h"
+#include "PhysicsSystem.h"
+#include "CollisionSystem.h"
+#include "Level.h"
+#include "SpritesheetRegistry.h"
+#include "Player.h"
+#include "Projectile.h"
+#include "TransformComponent.h"
+#include "PhysicsComponent.h"
+#include "CollisionComponent.h"
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+// Moves fast enough in one step to jump clean over a one tile thick wall or floor, and checks that the tile still
+// stops it. Each case checks Level::sweepRect() on its own, then a whole physics and collision step the way the game
+// runs one, but with a timescale of a full second instead of 1/60.
+
+namespace {
+    const int TILE_SIZE = 16;
+    const float TIMESCALE = 1.f;
+    // The sweep adds up its time of impact one tile at a time, so where that time puts the rect is checked to within
+    // rounding rather than exactly. Fixed-point rounds the most, about 1/30 of a pixel over these distances.
+    const float CONTACT_TOLERANCE = 0.125f;
+
+    bool passed = true;
+
+    void check(bool condition, const char* what) {
+        if(!condition) {
+            std::printf("FAILED: %s\n", what);
+            passed = false;
+        }
+    }
+
+    Level createLevel(int width, int height) {
+        Level level;
+        level.setTileSize(TILE_SIZE);
+        level.setTilemap(std::vector<std::vector<Tile>>(height, std::vector<Tile>(width)));
+        return level;
+    }
+
+    struct World {
+        std::unique_ptr<EntityComponentSystem> ecs;
+        std::shared_ptr<PhysicsSystem> physics;
+        std::shared_ptr<CollisionSystem> collision;
+    };
+
+    World createWorld() {
+        World world;
+        world.ecs = std::make_unique<EntityComponentSystem>();
+        world.ecs->init();
+        world.physics = world.ecs->registerSystem<PhysicsSystem>();
+        world.collision = world.ecs->registerSystem<CollisionSystem>();
+        return world;
+    }
+
+    bool queuedForDestruction(EntityComponentSystem& ecs, Entity entity) {
+        for(auto& command : ecs.getCommandBuffer().take()) {
+            if(command.entity == entity && !command.apply) return true;
+        }
+        return false;
+    }
+
+    // A projectile heads right at a wall in column 10, which it would be 120 px past by the end of the step
+    void fireProjectileAtWall() {
+        Level level = createLevel(20, 6);
+        for(int y = 0; y < 6; ++y) level.setTileAt(10, y, Tile{TileType::SOLID});
+        int wallLeft = 10 * TILE_SIZE;
+
+        World world = createWorld();
+        Entity projectile = prefab::Projectile::create(world.ecs.get(), {16.f, 40.f}, Direction::EAST);
+        auto& transform = world.ecs->getComponent<TransformComponent>(projectile);
+        auto& collision = world.ecs->getComponent<CollisionComponent>(projectile);
+        strb::real speed = world.ecs->getComponent<PhysicsComponent>(projectile).velocity.x;
+        strb::vec2 start = transform.position + collision.collisionRectOffset;
+        strb::vec2 size = {(float) collision.collisionRect.w, (float) collision.collisionRect.h};
+        strb::real displacement = speed * TIMESCALE;
+        check(start.x + size.x + displacement > wallLeft + TILE_SIZE, "projectile: the step does not clear the wall");
+
+        TileSweep sweep = level.sweepRect(start, size, {displacement, 0.f}, {TileType::SOLID});
+        check(sweep.hit, "projectile: sweep misses the wall");
+        check(sweep.tileX == 10 && sweep.tileY == (int) start.y / TILE_SIZE, "projectile: sweep hits the wrong tile");
+        check(strb::abs(start.x + size.x + displacement * sweep.time - wallLeft) < CONTACT_TOLERANCE,
+            "projectile: time of impact does not put it against the wall");
+        check(sweep.normal.x == -1.f && sweep.normal.y == 0.f, "projectile: wrong normal");
+
+        // Projectiles are destroyed by the wall they hit rather than stopped against it
+        world.physics->updateX(TIMESCALE);
+        world.collision->checkForLevelCollisionsOnXAxis(&level, TIMESCALE);
+        check(queuedForDestruction(*world.ecs, projectile), "projectile: goes through the wall");
+    }
+
+    // The player falls at full speed onto a floor in row 15, which they would be 64 px below by the end of the step
+    void dropPlayerOntoFloor() {
+        Level level = createLevel(6, 20);
+        for(int x = 0; x < 6; ++x) level.setTileAt(x, 15, Tile{TileType::SOLID});
+        int floorTop = 15 * TILE_SIZE;
+
+        World world = createWorld();
+        Entity player = prefab::Player::create(world.ecs.get(), {32.f, 0.f});
+        auto& transform = world.ecs->getComponent<TransformComponent>(player);
+        auto& physics = world.ecs->getComponent<PhysicsComponent>(player);
+        auto& collision = world.ecs->getComponent<CollisionComponent>(player);
+        physics.velocity.y = physics.maxVelocity.y;
+        strb::vec2 start = transform.position + collision.collisionRectOffset;
+        strb::vec2 size = {(float) collision.collisionRect.w, (float) collision.collisionRect.h};
+        strb::real displacement = physics.maxVelocity.y * TIMESCALE;
+        check(start.y + displacement > floorTop + TILE_SIZE, "player: the step does not clear the floor");
+
+        TileSweep sweep = level.sweepRect(start, size, {0.f, displacement}, {TileType::SOLID});
+        check(sweep.hit, "player: sweep misses the floor");
+        check(sweep.tileX == (int) start.x / TILE_SIZE && sweep.tileY == 15, "player: sweep hits the wrong tile");
+        check(strb::abs(start.y + size.y + displacement * sweep.time - floorTop) < CONTACT_TOLERANCE,
+            "player: time of impact does not put them on the floor");
+        check(sweep.normal.x == 0.f && sweep.normal.y == -1.f, "player: wrong normal");
+
+        world.physics->updateX(TIMESCALE);
+        world.collision->checkForLevelCollisionsOnXAxis(&level, TIMESCALE);
+        world.physics->updateY(TIMESCALE);
+        world.collision->checkForLevelCollisionsOnYAxis(&level, TIMESCALE);
+        check(transform.position.y + collision.collisionRectOffset.y + size.y == floorTop, "player: not standing on the floor");
+        check(collision.collidingDown && physics.touchingGround, "player: floor contact not recorded");
+        check(physics.velocity.y == 0.f, "player: still falling");
+    }
+}
+
+int main() {
+    if(!SpritesheetRegistry::loadSpritesheets(nullptr)) {
+        std::printf("Failed to load spritesheets\n");
+        return 1;
+    }
+
+    fireProjectileAtWall();
+    dropPlayerOntoFloor();
+    return passed ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include "HeadlessPlatform.h"
+#include "GameState.h"
+#include "SpritesheetRegistry.h"
+#include "TransformComponent.h"
+#include "InputComponent.h"
+#include "WeaponComponent.h"
+#include "EntityHandle.h"
+#include "PhysicsKernels.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// Plays the level with scripted input and hashes the position of every entity after every tick, so any change to how
+// the simulation plays out changes the hash. Each playthrough is played twice and has to give the same hash both
+// times, then again with the physics integrated by each kernel set the CPU supports, which has to change nothing.
+// Fixed-point builds are bit-exact on every compiler and machine, so there the hashes are also checked against known
+// values. A change that alters the simulation on purpose has to update them.
+
+namespace {
+    const int TICKS = 3600;
+
+    struct Playthrough {
+        const char* name;
+        // Starts with the weapon and the double jump, so that projectiles are covered too
+        bool armed;
+        std::uint64_t fixedPointHash;
+    };
+
+    const Playthrough PLAYTHROUGHS[] = {
+        {"walk and jump", false, 0xd3cdf186106784d3ull},
+        {"armed", true, 0x954a5aa8171900fbull},
+    };
+
+    // FNV-1a
+    std::uint64_t hashBytes(std::uint64_t hash, const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for(size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    // Walks right, then back left, over and over, jumping and shooting on a fixed beat
+    void pressKeys(int tick) {
+        headless::releaseAllKeys();
+        int phase = (tick / 240) % 6;
+        if(phase == 0 || phase == 1 || phase == 3 || phase == 4) headless::setKeyDown(SDL_SCANCODE_RIGHT, true);
+        if(phase == 2 || phase == 5) headless::setKeyDown(SDL_SCANCODE_LEFT, tick % 500 < 300);
+        if(tick % 37 < 8) headless::setKeyDown(SDL_SCANCODE_UP, true);
+        if(tick % 23 < 3) headless::setKeyDown(SDL_SCANCODE_Z, true);
+    }
+
+    // Entities are hashed in slot order, so that the hash does not depend on how the storage orders them
+    std::uint64_t hashWorld(std::uint64_t hash, EntityComponentSystem* ecs) {
+        auto transforms = ecs->getAllOf<TransformComponent>();
+        std::vector<Entity> entities(transforms.begin(), transforms.end());
+        std::sort(entities.begin(), entities.end(), [](Entity a, Entity b) {
+            return entityHandle::getIndex(a) < entityHandle::getIndex(b);
+        });
+        for(Entity entity : entities) {
+            std::uint32_t index = entityHandle::getIndex(entity);
+            auto& transform = ecs->getComponent<TransformComponent>(entity);
+            hash = hashBytes(hash, &index, sizeof(index));
+            hash = hashBytes(hash, &transform.position, sizeof(transform.position));
+        }
+        return hash;
+    }
+
+    // kernels is nullptr for the per-entity physics loop the game uses
+    bool play(const Playthrough& playthrough, const physicsKernels::KernelSet* kernels, std::uint64_t& hash) {
+        Audio audio;
+        Settings settings;
+        settings.loadSettings("settings.cfg");
+        Text text[] = {Text(nullptr), Text(nullptr), Text(nullptr), Text(nullptr)};
+
+        GameState gameState;
+        gameState.setGameSize(320, 180);
+        gameState.setRenderer(nullptr);
+        gameState.setAudioPlayer(&audio);
+        gameState.setSettings(&settings);
+        for(int i = 0; i < 4; ++i) gameState.addText((TextSize) i, &text[i]);
+        if(!gameState.init()) return false;
+        gameState.getPhysicsSystem()->setKernels(kernels);
+
+        EntityComponentSystem* ecs = gameState.getWorld();
+        if(playthrough.armed) {
+            ecs->addComponent<WeaponComponent>(gameState.getPlayer(), WeaponComponent{});
+            ecs->getComponent<InputComponent>(gameState.getPlayer()).allowedInputs.push_back(InputEvent::JUMP);
+        }
+
+        hash = 1469598103934665603ull;
+        for(int tick = 0; tick < TICKS; ++tick) {
+            pressKeys(tick);
+            gameState.tick(1.f / 60.f);
+            gameState.render();
+            hash = hashWorld(hash, ecs);
+        }
+        return true;
+    }
+}
+
+int main() {
+    if(!SpritesheetRegistry::loadSpritesheets(nullptr)) {
+        std::printf("Failed to load spritesheets\n");
+        return 1;
+    }
+
+    std::vector<const physicsKernels::KernelSet*> kernelSets = {&physicsKernels::scalar()};
+    if(physicsKernels::sse2()) kernelSets.push_back(physicsKernels::sse2());
+    if(physicsKernels::avx2()) kernelSets.push_back(physicsKernels::avx2());
+
+    bool passed = true;
+    for(auto& playthrough : PLAYTHROUGHS) {
+        std::uint64_t first = 0;
+        std::uint64_t second = 0;
+        if(!play(playthrough, nullptr, first) || !play(playthrough, nullptr, second)) {
+            std::printf("%s: failed to start the game\n", playthrough.name);
+            return 1;
+        }
+        std::printf("%s: %016llx\n", playthrough.name, (unsigned long long) first);
+        if(first != second) {
+            std::printf("%s: second run hashed to %016llx\n", playthrough.name, (unsigned long long) second);
+            passed = false;
+        }
+        for(auto kernels : kernelSets) {
+            std::uint64_t batched = 0;
+            if(!play(playthrough, kernels, batched)) {
+                std::printf("%s: failed to start the game\n", playthrough.name);
+                return 1;
+            }
+            if(batched != first) {
+                std::printf("%s: %s kernels hashed to %016llx\n", playthrough.name, kernels->name,
+                    (unsigned long long) batched);
+                passed = false;
+            }
+        }
+#ifdef FIXED_POINT_SIMULATION
+        if(first != playthrough.fixedPointHash) {
+            std::printf("%s: expected %016llx\n", playthrough.name, (unsigned long long) playthrough.fixedPointHash);
+            passed = false;
+        }
+#endif
+    }
+    return passed ? 0 : 1;
+}
\ No newline at end of file